@@ -1,9 +1,9 @@
 /*
  *  minikernel/include/const.h
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -37,7 +37,7 @@
 #define BLOQUEADO 3
 
 /*
- * Niveles de ejecucin del procesador. 
+ * Niveles de ejecución del procesador. 
  */
 #define NUM_NIVELES 3
 #define NIVEL_1 1 /* Int. SW */
@@ -69,14 +69,12 @@
 
 /* constantes usada en implementacion de mutex */
 #define NUM_MUT 16 /* numero total de mutex en el sistema */
-#define NUM_MUT_PROC 4 /* numero maximo de mutex que puede tener
-			  abiertos un proceso */
 #define MAX_NOM_MUT 8 /* longitud maxima de un nombre de mutex */
 
 /* constante usada en implementacion de manejador de terminal */
-#define TAM_BUF_TERM 8 /* tamao del buffer del terminal */
+#define TAM_BUF_TERM 8 /* tamaño del buffer del terminal */
 
-/* direccin de puerto de E/S del terminal */
+/* dirección de puerto de E/S del terminal */
 #define DIR_TERMINAL 1
 
 #endif /* _CONST_H */
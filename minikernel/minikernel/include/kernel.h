@@ -1,9 +1,9 @@
 /*
  *  minikernel/include/kernel.h
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  * 
  *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
  */
@@ -25,15 +25,279 @@
 
 #include "string.h"
 
+/*
+ * Consola del nucleo. printk y escribir no escriben en pantalla sino en un
+ * buffer circular de TAM_CONSOLA bytes (potencia de dos), que se vuelca de
+ * una vez cuando el procesador no tiene nada que hacer (espera_int) o en
+ * cuanto lo pendiente llega a MARCA_CONSOLA. panico lo vuelca antes de
+ * mostrar su mensaje. Lo ultimo escrito, hasta TAM_CONSOLA bytes, se puede
+ * leer con leer_log. Cada printk se formatea en TAM_LINEA_CONSOLA bytes.
+ */
+#define TAM_CONSOLA 4096
+#define MARCA_CONSOLA (TAM_CONSOLA*3/4)
+#define TAM_LINEA_CONSOLA 256
+int printk_consola(const char *formato, ...);
+void panico_consola(char *mens);
+#define printk(...) printk_consola(__VA_ARGS__)
+#define panico(mens) panico_consola(mens)
+
+/*
+ * Niveles de los mensajes del nucleo. Los de nivel mayor que NIVEL_LOG
+ * desaparecen al compilar; se fija con "make LOG=<nivel>" y por defecto se
+ * conserva toda la traza. "make medir", desde el directorio global o desde
+ * el del nucleo, compila con LOG_AVISO, sin las trazas de las rutas
+ * frecuentes, o con el LOG que se le de. En ejecucion, fijar_umbral_log puede
+ * acallar ademas los de nivel mayor que umbral_log.
+ */
+#define LOG_ERROR 0
+#define LOG_AVISO 1
+#define LOG_INFO 2
+#define LOG_DEPURACION 3
+#define LOG_TRAZA 4
+#ifndef NIVEL_LOG
+#define NIVEL_LOG LOG_TRAZA
+#endif
+#define printk_nivel(nivel, ...) \
+	do { if ((nivel) <= umbral_log) printk(__VA_ARGS__); } while (0)
+#if NIVEL_LOG >= LOG_ERROR
+#define printk_error(...) printk_nivel(LOG_ERROR, __VA_ARGS__)
+#else
+#define printk_error(...) do { } while (0)
+#endif
+#if NIVEL_LOG >= LOG_AVISO
+#define printk_aviso(...) printk_nivel(LOG_AVISO, __VA_ARGS__)
+#else
+#define printk_aviso(...) do { } while (0)
+#endif
+#if NIVEL_LOG >= LOG_INFO
+#define printk_info(...) printk_nivel(LOG_INFO, __VA_ARGS__)
+#else
+#define printk_info(...) do { } while (0)
+#endif
+#if NIVEL_LOG >= LOG_DEPURACION
+#define printk_depuracion(...) printk_nivel(LOG_DEPURACION, __VA_ARGS__)
+#else
+#define printk_depuracion(...) do { } while (0)
+#endif
+#if NIVEL_LOG >= LOG_TRAZA
+#define printk_traza(...) printk_nivel(LOG_TRAZA, __VA_ARGS__)
+#else
+#define printk_traza(...) do { } while (0)
+#endif
+
 #define NO_RECURSIVO 0
 #define RECURSIVO 1
+//Plazo de las esperas sin limite y plazo maximo en ticks de las que lo tienen
+#define ESPERA_INDEFINIDA -1
+#define MAX_PLAZO (1U<<30)
+//Numero maximo de mutex que se pueden tomar juntos con lock_multiple
+#define MAX_LOCK_MULTIPLE 8
+
+//Politica de los cerrojos de lectores/escritores
+#define PREFIERE_LECTORES 0
+#define PREFIERE_ESCRITORES 1
+
+//Modos de leer: crudo, con lo que haya, o canonico, por lineas completas
+#define LEER_CRUDO 0
+#define LEER_CANONICO 1
+
+/*
+ * Buffer circular de la entrada del terminal. Los indices de cabeza y cola
+ * solo avanzan y la posicion se obtiene con una mascara, por lo que el
+ * tamano tiene que ser potencia de dos. Se cambia con "make BUFTERM=<tam>".
+ */
+#ifndef TAM_BUF_TERMINAL
+#define TAM_BUF_TERMINAL 64
+#endif
+#define MASCARA_BUF_TERMINAL (TAM_BUF_TERMINAL-1)
+#if TAM_BUF_TERMINAL <= 0 || (TAM_BUF_TERMINAL & MASCARA_BUF_TERMINAL) != 0
+#error "TAM_BUF_TERMINAL tiene que ser potencia de dos"
+#endif
+//Caracteres de edicion del modo canonico: borrar el ultimo caracter de la
+//linea (DEL o retroceso) y borrar toda la linea (^U)
+#define CAR_BORRAR 0x7f
+#define CAR_RETROCESO '\b'
+#define CAR_BORRAR_LINEA 0x15
+
+/*
+ * Prioridades de planificacion. Un valor mayor indica mas prioridad.
+ * Cada prioridad tiene su propia cola de listos y un bit en el mapa
+ * de colas no vacias, por lo que el numero de niveles no puede superar
+ * el numero de bits de un unsigned int.
+ */
+#define NUM_PRIORIDADES 8
+#define PRIO_MIN 0
+#define PRIO_MAX (NUM_PRIORIDADES-1)
+#define PRIO_DEFECTO 3
+
+/*
+ * Politicas de planificacion. Se elige al compilar el sistema con
+ * "make PLANIF=<politica>"; por defecto prioridades fijas.
+ *   PLANIF_PRIORIDADES: cada proceso se queda en la prioridad que fije.
+ *   PLANIF_MLFQ: colas multinivel realimentadas; cada prioridad es un
+ *	nivel con su propia rodaja (rodajas_mlfq). Agotar la rodaja baja
+ *	un nivel, bloquearse en dormir o leer_caracter sube uno y cada
+ *	PERIODO_BOOST_MLFQ ticks todos los procesos vuelven al nivel maximo.
+ *   PLANIF_CFS: reparto proporcional por tiempo virtual. Se ejecuta el
+ *	proceso listo con menor vruntime; la prioridad fija su peso.
+ *   PLANIF_STRIDE: reparto proporcional determinista por tickets. Cada
+ *	tick ejecutado suma al pase del proceso su zancada (inversa a sus
+ *	tickets) y se ejecuta el listo con menor pase.
+ */
+#define PLANIF_PRIORIDADES 0
+#define PLANIF_MLFQ 1
+#define PLANIF_CFS 2
+#define PLANIF_STRIDE 3
+
+#ifndef POLITICA_PLANIF
+#define POLITICA_PLANIF PLANIF_PRIORIDADES
+#endif
+
+/* Politicas que guardan los listos en un monticulo en vez de en colas */
+#define USA_MONTICULO (POLITICA_PLANIF==PLANIF_CFS || POLITICA_PLANIF==PLANIF_STRIDE)
+
+#define PERIODO_BOOST_MLFQ (2*TICK)
+
+/*
+ * CFS: el vruntime se mide en 1/PESO_BASE de tick ponderado.
+ *   LATENCIA_CFS: ticks en los que deberian ejecutar todos los listos.
+ *   GRANULARIDAD_CFS: rodaja minima en ticks.
+ *   CREDITO_DORMIDO_CFS: ventaja maxima (en ticks de peso base) con la
+ *	que vuelve un proceso que ha estado bloqueado.
+ *   GRANULARIDAD_DESPERTAR_CFS: ventaja (en ticks de peso base) que
+ *	debe tener un proceso despertado para expulsar al actual.
+ */
+#define PESO_BASE 1024
+#define LATENCIA_CFS 20
+#define GRANULARIDAD_CFS 2
+#define CREDITO_DORMIDO_CFS 10
+#define GRANULARIDAD_DESPERTAR_CFS 1
+
+/*
+ * Stride: la zancada de un proceso es ZANCADA_BASE/tickets.
+ */
+#define ZANCADA_BASE (1<<20)
+#define TICKETS_DEFECTO 100
+#define MAX_TICKETS 10000
+
+/*
+ * Clase de tiempo real EDF, por encima de cualquier politica: un proceso
+ * declara periodo, presupuesto y plazo relativo (en ticks), y entre los
+ * procesos EDF listos se ejecuta el de plazo absoluto mas cercano. La
+ * utilizacion (presupuesto/periodo) se mide en partes de UTIL_ESCALA y
+ * la suma de la de todos los procesos EDF no puede superar UTIL_ESCALA.
+ */
+#define UTIL_ESCALA 10000
+
+/*
+ * Rueda de temporizacion de los procesos dormidos. Cada proceso dormido
+ * esta en la cubeta de su instante absoluto de despertar modulo
+ * NUM_CUBETAS_RUEDA, ordenada por ese instante, por lo que en cada tick
+ * solo se mira el principio de la cubeta que vence. Debe ser potencia de 2.
+ */
+#define NUM_CUBETAS_RUEDA 64
+
+/*
+ * Holgura de temporizacion: un proceso dormido con holgura h puede
+ * despertar hasta h ticks tarde, lo que permite agrupar despertares en un
+ * mismo tick. La holgura inicial de cada proceso se fija al compilar el
+ * sistema con "make HOLGURA=<ticks>" y cada proceso puede cambiarla.
+ */
+#ifndef HOLGURA_DEFECTO
+#define HOLGURA_DEFECTO 0
+#endif
+#define MAX_HOLGURA TICK
+
+/*
+ * Prorroga de la rodaja: si a un proceso se le acaba la rodaja siendo
+ * propietario de un mutex, o tras pedir que se aplace
+ * su expulsion, se le conceden PRORROGA_MUTEX ticks mas, una sola vez, y
+ * cede el procesador en cuanto deja de necesitarlos. Se activa compilando
+ * con "make PRORROGA=<ticks>"; con 0 no hay prorroga.
+ */
+#ifndef PRORROGA_MUTEX
+#define PRORROGA_MUTEX 0
+#endif
+
+/*
+ * Espacio de nombres del nucleo: asocia nombres de hasta MAX_NOM_MUT
+ * caracteres, guardados en la propia entrada, a los objetos con nombre
+ * (mutex, semaforos, variables condicion, cerrojos de lectores/escritores
+ * y barreras). Cada clase de objeto tiene sus propios nombres y el objeto
+ * se identifica por su indice en la tabla de su clase. La busqueda es por
+ * dispersion, con listas de colision por cubeta. MAX_NOMBRES debe bastar
+ * para todos los objetos de todas las clases a la vez y
+ * NUM_CUBETAS_NOMBRES debe ser potencia de 2.
+ */
+#define MAX_NOMBRES 128
+#define NUM_CUBETAS_NOMBRES 64
+#define NOMBRE_LIBRE 0
+#define NOMBRE_MUTEX 1
+#define NOMBRE_SEM 2
+#define NOMBRE_COND 3
+#define NOMBRE_RWLOCK 4
+#define NOMBRE_BARRERA 5
+
+/*
+ * Descriptores de objetos del nucleo. Cada proceso tiene una tabla de
+ * MAX_DESCRIPTORES entradas y un mapa de bits de las libres, del que se
+ * reserva la primera libre. El descriptor que recibe el usuario lleva el
+ * numero de entrada en sus BITS_DESCRIPTOR bits bajos y la generacion de
+ * la entrada en el resto; la generacion avanza al cerrarla, por lo que un
+ * descriptor cerrado deja de valer aunque se reutilice su entrada. Cada
+ * entrada indica el tipo de objeto al que se refiere.
+ */
+#define BITS_DESCRIPTOR 5
+#define MAX_DESCRIPTORES (1<<BITS_DESCRIPTOR)
+#define MAX_GENERACION (1<<(30-BITS_DESCRIPTOR))
+#define DESC_LIBRE 0
+#define DESC_MUTEX 1
+#define DESC_SEM 2
+#define DESC_COND 3
+#define DESC_RWLOCK 4
+#define DESC_BARRERA 5
+#define DESC_DISPOSITIVO 6
+
+/*
+ * Semaforos contadores con nombre: numero total en el sistema.
+ */
+#define NUM_SEM 16
+
+/*
+ * Variables condicion con nombre, que se usan junto a un mutex: numero
+ * total en el sistema.
+ */
+#define NUM_COND 16
+
+/*
+ * Cerrojos de lectores/escritores con nombre: numero total en el sistema.
+ */
+#define NUM_RWLOCK 16
 
 /*
-* Variable global que indica el tamano del buffer
-* de caracteres leidos.
-*/
-#define VACIO -2
-#define LLENO -1
+ * Barreras con nombre: numero total en el sistema. esperar_barrera
+ * devuelve BARRERA_ULTIMO al ultimo en llegar y 0 a los demas.
+ */
+#define NUM_BARRERA 8
+#define BARRERA_ULTIMO 1
+
+/*
+ * Dispositivos de caracteres, con su manejador en tabla_dispositivos y
+ * su numero como indice en ella. El eco devuelve lo que se le escribe,
+ * con un buffer circular de TAM_BUF_ECO bytes (potencia de dos); el nulo
+ * lo descarta todo y al leer da fin de fichero, y el cero da ceros.
+ */
+#define NUM_DISPOSITIVOS 4
+#define DISP_TERMINAL 0
+#define DISP_NULO 1
+#define DISP_CERO 2
+#define DISP_ECO 3
+#define TAM_BUF_ECO 1024
+
+/*
+ * Numero maximo de trozos de texto que se escriben juntos con escribirv
+ */
+#define MAX_VECTOR_ES 16
 
 /*
  *
@@ -43,15 +307,33 @@
  */
 typedef struct BCP_t *BCPptr;
 
+/*
+ *
+ * Definicion del tipo que corresponde con la cabecera de una lista
+ * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
+ * procesos bloqueados en semáforo, etc.).
+ *
+ */
+
+typedef struct{
+	BCPptr primero;
+	BCPptr ultimo;
+} lista_BCPs;
+
+//Entrada del espacio de nombres
+typedef struct {
+	char nombre[MAX_NOM_MUT+1];
+	int clase;		/* NOMBRE_LIBRE|NOMBRE_MUTEX|...|NOMBRE_BARRERA */
+	int indice;		/* posicion del objeto en la tabla de su clase */
+	int siguiente;		/* siguiente de la cubeta o de libres, -1 al final */
+} entrada_nombre;
+
 //Objetivo parcial 3
 typedef struct {
-        //El nombre del mutex
-        char *nombre;
+        //El nombre del mutex, tambien registrado en el espacio de nombres
+        char nombre[MAX_NOM_MUT+1];
 	//Indica si es recursivo o no
 	int tipo;          
-	int ocupado;
-	int procesos[MAX_PROC];             //Procesos con el mutex abierto	
-	int procesosBloqueados[MAX_PROC];   //Procesos bloqueados en el mutex
 	
 	//Muestra el proceso propietario del mutex
 	int propietario;
@@ -59,11 +341,84 @@ typedef struct {
 	int procesos_mutex;
         //Positivo numero de veces bloqueado, 0 que es libre y negativo error	
 	int bloqueado;	
+	//Procesos esperando el mutex, en orden de llegada
+	lista_BCPs lista_espera;
+	//Procesos que esperan con lock_multiple un conjunto que lo incluye,
+	//un bit por identificador
+	unsigned int esperan_multiple;
 }mutex;
 
+//Semaforo contador
+typedef struct {
+	char nombre[MAX_NOM_MUT+1];
+	int valor;
+	//Numero de procesos que lo tienen abierto
+	int procesos_sem;
+	//Procesos esperando en esperar_sem, en orden de llegada
+	lista_BCPs lista_espera;
+} semaforo;
+
+//Variable condicion
+typedef struct {
+	char nombre[MAX_NOM_MUT+1];
+	//Numero de procesos que la tienen abierta
+	int procesos_cond;
+	//Procesos esperando en cond_wait, en orden de llegada
+	lista_BCPs lista_espera;
+} condicion;
+
+//Cerrojo de lectores/escritores
+typedef struct {
+	char nombre[MAX_NOM_MUT+1];
+	//PREFIERE_LECTORES o PREFIERE_ESCRITORES
+	int politica;
+	//Numero de procesos que lo tienen abierto
+	int procesos_rw;
+	//Lectores dentro, con un bit por proceso, y escritor dentro (-1 si no hay)
+	int lectores;
+	unsigned int mapa_lectores;
+	int escritor;
+	//Procesos esperando para leer y para escribir, en orden de llegada
+	lista_BCPs lectores_espera;
+	lista_BCPs escritores_espera;
+	//Accesos que han tenido que esperar y ticks esperados, por tipo
+	int esperas_lectores;
+	int ticks_lectores;
+	int esperas_escritores;
+	int ticks_escritores;
+} cerrojo_rw;
+
+//Barrera para un numero fijo de procesos
+typedef struct {
+	char nombre[MAX_NOM_MUT+1];
+	//Procesos que tienen que llegar para abrirla y los que esperan ya
+	int n;
+	int llegados;
+	//Numero de procesos que la tienen abierta
+	int procesos_barrera;
+	//Procesos esperando en la barrera
+	lista_BCPs lista_espera;
+} barrera;
+
+//Trozo de texto de escribirv
+typedef struct {
+	char *texto;
+	unsigned int longi;
+} vector_es;
+
+//Manejador de un dispositivo de caracteres. leer y escribir devuelven los
+//bytes leidos o escritos y sondear si se puede leer sin esperar
 typedef struct {
-	int descript;
-	int libre;	
+	char *nombre;
+	int (*leer)(char *buf, unsigned int n);
+	int (*escribir)(char *buf, unsigned int n);
+	int (*sondear)();
+} manejador_dispositivo;
+
+typedef struct {
+	int tipo;		/* DESC_LIBRE|DESC_MUTEX|...|DESC_BARRERA */
+	int objeto;		/* indice del objeto en la tabla de su tipo */
+	int generacion;
 } tipo_descriptor;
 
 typedef struct BCP_t {
@@ -72,11 +427,29 @@ typedef struct BCP_t {
         contexto_t contexto_regs;	/* copia de regs. de UCP */
         void * pila;			/* dir. inicial de la pila */
 	BCPptr siguiente;		/* puntero a otro BCP */
+	BCPptr anterior;		/* y al anterior de la lista */
 	void *info_mem;			/* descriptor del mapa de memoria */
-        //Objetivo 2, plazo que falta para que se despierte un proceso  
-        unsigned int plazo; 
+        //Objetivo 2, instante absoluto (en ticks) en el que se despierta
+        unsigned int despertar;
+	//Enlaces en la cubeta de la rueda de dormidos
+	BCPptr sig_temp;
+	BCPptr ant_temp;
+	//Ticks que puede retrasarse su despertar para agruparlo con otros
+	unsigned int holgura;
+	//Lista en la que espera con un plazo, que tambien esta en la rueda
+	//(NULL si no espera con plazo), e indicacion de que el plazo vencio
+	lista_BCPs *espera_con_plazo;
+	int plazo_vencido;
 	//Objetivo 4, tiempo que le queda a la actual rodaja
 	unsigned int rodaja;	
+	//Ha pedido que se aplace su expulsion; esta en prorroga y desde cuando
+	int aplazar_expulsion;
+	int en_prorroga;
+	int inicio_prorroga;
+	//Lectura del terminal que espera: si es canonica y cuantos caracteres
+	//le bastan si no llega una linea completa
+	int lectura_canonica;
+	unsigned int lectura_minima;
 	//unsigned int segs;		/* segundos que permance dormido el proceso*/
 	int replanificacion;	        /* booleano para saber cuando hay que hacer un cambio de contexto involuntario */
 
@@ -85,38 +458,76 @@ typedef struct BCP_t {
 	//Numero de veces interrupido en usuario
 	int veces_usuario;		 			
 	
-	//Objetivo parcial 3, numero de mutex
-	int numeroMutex;
-	mutex *array_mutex_proceso[NUM_MUT_PROC];
-	tipo_descriptor descriptores[NUM_MUT_PROC];
-	
-	//Indica que esta bloqueado por crear mutex 
-	int blocCreandoMutex;
-	//Indica el mutex que tiene bloqueado al proceso
-	char *bloqueadoPorMutex;  
+	//Objetivo parcial 3, descriptores de los objetos abiertos
+	tipo_descriptor descriptores[MAX_DESCRIPTORES];
+	//Mapa de bits de las entradas de descriptores libres
+	unsigned int descriptores_libres;
 	
         //Inicio de bloqueo
 	int instante_bloqueo;		
         //Segundos bloqueados
 	int seg_bloqueo;
 	
-	//Objetivo parcial 5
-	//Indica que esta bloqueado por lectura de caracter
-	int blocLectura;
+	//Prioridad efectiva del proceso, indica en que cola de listos se
+	//inserta: la mayor entre la propia (base) y la heredada de los que
+	//esperan algun mutex suyo (-1 si no hereda ninguna)
+	int prioridad;
+	int prioridad_base;
+	int prioridad_heredada;
+	//Mutex por el que esta esperando, para propagar la herencia
+	mutex *mutex_esperado;
+	//Mutex que solto al esperar en una variable condicion y numero de
+	//bloqueos que tenia sobre el, que recupera al volver de cond_wait
+	mutex *mutex_cond;
+	int bloqueos_cond;
+	//Conjunto de mutex que espera con lock_multiple y turno en el que
+	//empezo a esperar un mutex, para cederlo por orden de llegada
+	int conjunto_multiple[MAX_LOCK_MULTIPLE];
+	int n_multiple;
+	unsigned int turno_espera;
+
+	//Instante en el que paso de bloqueado a listo (-1 si no esta pendiente)
+	int instante_listo;
+	//Ticks acumulados entre despertar y ejecutar, y numero de despertares
+	int latencia_total;
+	int n_despertares;
+
+	//CFS: tiempo virtual consumido, ponderado por el peso de su prioridad
+	unsigned long long vruntime;
+	//Stride: tickets del proceso, zancada que le corresponde y pase actual
+	int tickets;
+	unsigned long long zancada;
+	unsigned long long pase;
+
+	//EDF: indica si el proceso pertenece a la clase EDF y sus parametros
+	int edf;
+	int periodo;
+	int presupuesto;
+	int plazo_relativo;
+	int utilizacion;
+	//EDF: estado del periodo actual
+	int presupuesto_restante;
+	int siguiente_activacion;
+	int plazo_absoluto;
+	int pendiente;		//tiene trabajo del periodo actual sin terminar
+	int retenido;		//ha agotado el presupuesto del periodo actual
+	int fallos_plazo;
+	//Enlaces y clave del monticulo de listos. ant_mont es el padre si es
+	//su primer hijo y si no el hermano anterior
+	unsigned long long clave;
+	BCPptr hijo;
+	BCPptr hermano;
+	BCPptr ant_mont;
 } BCP;
 
 /*
- *
- * Definicion del tipo que corresponde con la cabecera de una lista
- * de BCPs. Este tipo se puede usar para diversas listas (procesos listos,
- * procesos bloqueados en semforo, etc.).
- *
+ * Monticulo de emparejamiento de BCPs ordenado por el campo clave
+ * (menor clave en la raiz). Lo usan las politicas que eligen por un
+ * valor numerico en lugar de por orden de llegada.
  */
-
 typedef struct{
-	BCP *primero;
-	BCP *ultimo;
-} lista_BCPs;
+	BCP *raiz;
+} monticulo_BCPs;
 
 	
 /*
@@ -132,22 +543,55 @@ BCP * p_proc_actual=NULL;
 BCP tabla_procs[MAX_PROC];
 
 //Objetivo 2
-//Variable global que representa la cola de procesos listos
-lista_BCPs lista_listos= {NULL, NULL};
-//Variable global que representa la cola de procesos dromidos
-lista_BCPs lista_dormidos = {NULL, NULL};
+//Variable global que representa las colas de procesos listos, una por prioridad.
+//El proceso en ejecucion no esta en ninguna de ellas
+lista_BCPs lista_listos[NUM_PRIORIDADES];
+//Mapa de bits de las colas de listos no vacias (bit i -> lista_listos[i])
+unsigned int mapa_listos = 0;
+//MLFQ: rodaja de cada nivel, mas corta cuanto mas prioritario
+unsigned int rodajas_mlfq[NUM_PRIORIDADES] = {40, 30, 20, 15, 10, 6, 4, 2};
+//Numero de procesos en la estructura de listos (sin contar el actual)
+int n_listos = 0;
+//CFS: monticulo de listos por vruntime, suma de sus pesos y vruntime minimo
+monticulo_BCPs monticulo_listos = {NULL};
+int peso_listos = 0;
+unsigned long long min_vruntime = 0;
+//CFS: peso de cada prioridad, cada nivel recibe un 25% mas que el anterior
+int pesos_cfs[NUM_PRIORIDADES] = {524, 655, 820, 1024, 1280, 1600, 2000, 2500};
+//Stride: menor pase entre los procesos listos y el actual
+unsigned long long pase_global = 0;
+//EDF: monticulo de listos por plazo absoluto, procesos que han agotado su
+//presupuesto hasta el siguiente periodo y utilizacion total admitida
+monticulo_BCPs monticulo_edf = {NULL};
+lista_BCPs lista_edf_agotados = {NULL, NULL};
+int utilizacion_edf = 0;
+//Variable global que representa la rueda de procesos dormidos; cada
+//cubeta se enlaza por sig_temp/ant_temp
+lista_BCPs rueda_dormidos[NUM_CUBETAS_RUEDA];
+//Despertares que se han ahorrado al agrupar dormidos gracias a la holgura
+int despertares_ahorrados = 0;
 
 //Objetivo 3
 //Variable global que representa al la lista de colas al crear el mutex
 lista_BCPs lista_de_mutex = {NULL, NULL};
-//Variable global para el lock y unlock de la lista de procesos bloqueados 
-lista_BCPs lista_de_bloqueados = {NULL, NULL};
+//Procesos esperando a que se les pueda dar todo un conjunto de mutex
+//(lock_multiple)
+lista_BCPs lista_lock_multiple = {NULL, NULL};
+//Siguiente turno de llegada a la espera de un mutex
+unsigned int turno_mutex = 0;
+//Veces que un proceso ha heredado la prioridad de otro que espera un mutex suyo
+int herencias_prioridad = 0;
+//Prorrogas de rodaja concedidas, ticks que han durado en total y las que se
+//han dejado antes de agotarlas
+int prorrogas_concedidas = 0;
+int ticks_prorroga = 0;
+int prorrogas_cedidas = 0;
 
 
 //Objetivo parcial 2, las dintintas variables
 //Variable global que indica el numero de interrupciones de reloj producidas desde el arranque del sistema
 int n_interrup;
-//Variable global que indica el nivel previo de interrupcin ante un cambio en el nivel de interrupcion
+//Variable global que indica el nivel previo de interrupción ante un cambio en el nivel de interrupcion
 int nivel_anterior;
 //Variable global que indica si estamos en modo sistema en una determinada zona
 //int accede = 0;
@@ -155,30 +599,79 @@ int nivel_anterior;
 //int numTicks = 0;
 
 
+//Espacio de nombres: entradas, primera entrada de cada cubeta y de la
+//lista de libres, y coste acumulado de las busquedas
+entrada_nombre tabla_nombres[MAX_NOMBRES];
+int cubetas_nombres[NUM_CUBETAS_NOMBRES];
+int nombres_libres;
+int busquedas_nombres = 0;
+int comparaciones_nombres = 0;
+
 //Objetivo 3
-//Array de mutex
+//Array de mutex y mapa de bits de sus entradas libres
 mutex array_mutex[NUM_MUT];
+unsigned int mutex_libres = (1U << NUM_MUT) - 1;
+//Array de semaforos y mapa de bits de sus entradas libres
+semaforo array_sem[NUM_SEM];
+unsigned int sem_libres = (1U << NUM_SEM) - 1;
+//Array de variables condicion y mapa de bits de sus entradas libres
+condicion array_cond[NUM_COND];
+unsigned int cond_libres = (1U << NUM_COND) - 1;
+//Array de cerrojos de lectores/escritores y mapa de bits de sus entradas libres
+cerrojo_rw array_rwlock[NUM_RWLOCK];
+unsigned int rwlock_libres = (1U << NUM_RWLOCK) - 1;
+//Array de barreras y mapa de bits de sus entradas libres
+barrera array_barrera[NUM_BARRERA];
+unsigned int barrera_libres = (1U << NUM_BARRERA) - 1;
 //variable que indica el numero de mutex que hay
 //int mutexExistentes = 0;
 
 //Objetivo 4
 //Variable global que indica si hay un cambio de contexto pendiente
 int replanificacion_pendiente=0;
+//Variable global que indica que el procesador esta parado en espera_int
+//y por tanto no hay ningun proceso en ejecucion
+int esperando_int=0;
 
 //Variable global para acceso a memoria por usuario
 //int accesoMem = 0;
 
 
 //Objetivo parcial 5
-//Buffer de caracteres procesados del terminal
-char Buffer[TAM_BUF_TERM];
-//Variable global que indica el nmero de caracteres en el buffer
-int BufferChar = 0;
+//Buffer circular de caracteres procesados del terminal. Hay cola-cabeza
+//caracteres, el primero en la posicion cabeza&MASCARA_BUF_TERMINAL
+char buffer_terminal[TAM_BUF_TERMINAL];
+unsigned int cabeza_terminal = 0;
+unsigned int cola_terminal = 0;
+//Caracteres que han llegado con el buffer lleno y se han perdido
+int perdidos_terminal = 0;
+//Disciplina de linea: si el terminal esta en modo canonico, donde empieza
+//la linea que aun se puede editar y cuantas lineas completas hay
+int canonico_terminal = 0;
+unsigned int inicio_linea_terminal = 0;
+int lineas_terminal = 0;
+//Procesos esperando a que llegue un caracter del terminal
+lista_BCPs lista_lectores = {NULL, NULL};
+
+//Buffer circular de la consola del nucleo. Lo pendiente de volcar en
+//pantalla va de volcado_consola a cola_consola y lo que le queda por leer
+//a leer_log empieza en lectura_log
+char buffer_consola[TAM_CONSOLA];
+unsigned int cola_consola = 0;
+unsigned int volcado_consola = 0;
+unsigned int lectura_log = 0;
+//Nivel maximo de los mensajes que se muestran, fijado en ejecucion
+int umbral_log = NIVEL_LOG;
+
+//Buffer circular del dispositivo eco, como el del terminal
+char buffer_eco[TAM_BUF_ECO];
+unsigned int cabeza_eco = 0;
+unsigned int cola_eco = 0;
 
 
 
 /*
- * Define cuntas veces se ha detectado que el proceso ejecuta en modo
+ * Define cuántas veces se ha detectado que el proceso ejecuta en modo
  * sistema y cuantas veces en modo usuario
  */
 typedef struct tiempo_ejecucion {
@@ -186,9 +679,38 @@ typedef struct tiempo_ejecucion {
     int sistema;
 } tiempo_ejecucion;
 
+/*
+ * Busquedas hechas en el espacio de nombres y entradas comparadas en ellas
+ */
+typedef struct coste_nombres {
+    int busquedas;
+    int comparaciones;
+} coste_nombres;
+
+/*
+ * Esperas en un cerrojo de lectores/escritores: accesos de cada tipo que
+ * han tenido que esperar y ticks esperados en total
+ */
+typedef struct esperas_rwlock {
+    int esperas_lectores;
+    int ticks_lectores;
+    int esperas_escritores;
+    int ticks_escritores;
+} esperas_rwlock;
+
+/*
+ * Prorrogas de rodaja concedidas, ticks que han durado en total y las que
+ * se han dejado antes de agotarlas
+ */
+typedef struct prorrogas {
+    int concedidas;
+    int ticks;
+    int cedidas;
+} prorrogas;
+
 /*
  *
- * Definicin del tipo que corresponde con una entrada en la tabla de
+ * Definición del tipo que corresponde con una entrada en la tabla de
  * llamadas al sistema.
  *
  */
@@ -209,6 +731,11 @@ int obtener_id_pr();
 
 //Objetivo parcial 2
 int dormir(); 
+int sis_dormir_ticks();
+int sis_dormir_hasta();
+int sis_obtener_ticks();
+int sis_fijar_holgura();
+int sis_despertares_ahorrados();
 
 //Objetivo parcial 3, todas las funciones del mutex
 int sis_crear_mutex();
@@ -216,10 +743,94 @@ int sis_abrir_mutex();
 int sis_lock();
 int sis_unlock();
 int sis_cerrar_mutex();
+int sis_lock_multiple();
+int sis_unlock_multiple();
+//Variantes que no esperan o esperan con plazo
+int sis_trylock();
+int sis_lock_timeout();
+int sis_intentar_crear_mutex();
+int sis_leer_caracter_timeout();
+//Prorroga de la rodaja
+int sis_aplazar_expulsion();
+int sis_prorrogas();
+//Caracteres del terminal perdidos
+int sis_caracteres_perdidos();
+//Lectura de varios caracteres, en modo crudo o canonico
+int sis_leer();
+//Dispositivos de caracteres
+int sis_abrir_dispositivo();
+int sis_leer_dispositivo();
+int sis_escribir_dispositivo();
+int sis_sondear_dispositivo();
+int sis_cerrar_dispositivo();
+//Lectura del registro de la consola del nucleo
+int sis_leer_log();
+int sis_fijar_umbral_log();
+//Escritura de varios trozos en una llamada
+int sis_escribirv();
+
+/*
+ * Funciones de los manejadores de dispositivos
+ */
+int leer_terminal(char *buf, unsigned int n);
+int escribir_terminal(char *buf, unsigned int n);
+int sondear_terminal();
+int leer_nulo(char *buf, unsigned int n);
+int escribir_nulo(char *buf, unsigned int n);
+int leer_cero(char *buf, unsigned int n);
+int leer_eco(char *buf, unsigned int n);
+int escribir_eco(char *buf, unsigned int n);
+int sondear_eco();
+int sondear_siempre();
 
 //Objetivo parcial 5
 int leer_caracter();
 
+//Prioridades
+int sis_fijar_prioridad();
+int sis_herencias_prioridad();
+
+//Espacio de nombres
+int sis_coste_nombres();
+
+//Semaforos contadores
+int sis_crear_sem();
+int sis_abrir_sem();
+int sis_esperar_sem();
+int sis_senalizar_sem();
+int sis_cerrar_sem();
+
+//Variables condicion
+int sis_crear_cond();
+int sis_abrir_cond();
+int sis_cond_wait();
+int sis_cond_signal();
+int sis_cond_broadcast();
+int sis_cerrar_cond();
+
+//Cerrojos de lectores/escritores
+int sis_crear_rwlock();
+int sis_abrir_rwlock();
+int sis_lock_lector();
+int sis_lock_escritor();
+int sis_unlock_rwlock();
+int sis_cerrar_rwlock();
+int sis_esperas_rwlock();
+
+//Barreras
+int sis_crear_barrera();
+int sis_abrir_barrera();
+int sis_esperar_barrera();
+int sis_cerrar_barrera();
+
+//Tiempos de ejecucion y tickets de stride
+int sis_tiempos_proceso();
+int sis_fijar_tickets();
+
+//Clase EDF
+int sis_fijar_edf();
+int sis_fallos_plazo();
+
 
 /*
  * Variable global que contiene las rutinas que realizan cada llamada
@@ -237,8 +848,71 @@ servicio tabla_servicios[NSERVICIOS]={	{sis_crear_proceso},
 {sis_unlock},
 {sis_cerrar_mutex},
 //Objetivo 5
-{leer_caracter}
+{leer_caracter},
+//Prioridades
+{sis_fijar_prioridad},
+{sis_tiempos_proceso},
+{sis_fijar_tickets},
+{sis_fijar_edf},
+{sis_fallos_plazo},
+{sis_dormir_ticks},
+{sis_dormir_hasta},
+{sis_obtener_ticks},
+{sis_fijar_holgura},
+{sis_despertares_ahorrados},
+{sis_herencias_prioridad},
+{sis_coste_nombres},
+{sis_crear_sem},
+{sis_abrir_sem},
+{sis_esperar_sem},
+{sis_senalizar_sem},
+{sis_cerrar_sem},
+{sis_crear_cond},
+{sis_abrir_cond},
+{sis_cond_wait},
+{sis_cond_signal},
+{sis_cond_broadcast},
+{sis_cerrar_cond},
+{sis_crear_rwlock},
+{sis_abrir_rwlock},
+{sis_lock_lector},
+{sis_lock_escritor},
+{sis_unlock_rwlock},
+{sis_cerrar_rwlock},
+{sis_esperas_rwlock},
+{sis_crear_barrera},
+{sis_abrir_barrera},
+{sis_esperar_barrera},
+{sis_cerrar_barrera},
+{sis_lock_multiple},
+{sis_unlock_multiple},
+{sis_trylock},
+{sis_lock_timeout},
+{sis_intentar_crear_mutex},
+{sis_leer_caracter_timeout},
+{sis_aplazar_expulsion},
+{sis_prorrogas},
+{sis_caracteres_perdidos},
+{sis_leer},
+{sis_abrir_dispositivo},
+{sis_leer_dispositivo},
+{sis_escribir_dispositivo},
+{sis_sondear_dispositivo},
+{sis_cerrar_dispositivo},
+{sis_leer_log},
+{sis_fijar_umbral_log},
+{sis_escribirv}
 }; 
 
+/*
+ * Tabla de manejadores de dispositivos, indexada por numero de dispositivo
+ */
+manejador_dispositivo tabla_dispositivos[NUM_DISPOSITIVOS]={
+{"terminal", leer_terminal, escribir_terminal, sondear_terminal},
+{"nulo", leer_nulo, escribir_nulo, sondear_siempre},
+{"cero", leer_cero, escribir_nulo, sondear_siempre},
+{"eco", leer_eco, escribir_eco, sondear_eco}
+};
+
 #endif /* _KERNEL_H */
 
@@ -1,9 +1,9 @@
 /*
  *  minikernel/kernel/include/llamsis.h
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  * 
  *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
  */
@@ -20,7 +20,7 @@
 #define _LLAMSIS_H
 
 /* Numero de llamadas disponibles */
-#define NSERVICIOS 11
+#define NSERVICIOS 63
 
 #define CREAR_PROCESO 0
 #define TERMINAR_PROCESO 1
@@ -36,6 +36,78 @@
 #define CERRAR_MUTEX 9
 //Objetivo parcial 5, llamada a entrada por teclado
 #define LEER_CARACTER 10
+//Prioridades, fija la prioridad del proceso actual
+#define FIJAR_PRIORIDAD 11
+//Ticks en modo usuario y sistema del proceso, y tickets de stride
+#define TIEMPOS_PROCESO 12
+#define FIJAR_TICKETS 13
+//Clase de tiempo real EDF
+#define FIJAR_EDF 14
+#define FALLOS_PLAZO 15
+//Dormir con resolucion de tick y contador de ticks
+#define DORMIR_TICKS 16
+#define DORMIR_HASTA 17
+#define OBTENER_TICKS 18
+//Holgura de temporizacion y despertares ahorrados al agrupar
+#define FIJAR_HOLGURA 19
+#define DESPERTARES_AHORRADOS 20
+//Numero de herencias de prioridad por mutex
+#define HERENCIAS_PRIORIDAD 21
+//Coste de las busquedas en el espacio de nombres
+#define COSTE_NOMBRES 22
+//Semaforos contadores
+#define CREAR_SEM 23
+#define ABRIR_SEM 24
+#define ESPERAR_SEM 25
+#define SENALIZAR_SEM 26
+#define CERRAR_SEM 27
+//Variables condicion
+#define CREAR_COND 28
+#define ABRIR_COND 29
+#define COND_WAIT 30
+#define COND_SIGNAL 31
+#define COND_BROADCAST 32
+#define CERRAR_COND 33
+//Cerrojos de lectores/escritores
+#define CREAR_RWLOCK 34
+#define ABRIR_RWLOCK 35
+#define LOCK_LECTOR 36
+#define LOCK_ESCRITOR 37
+#define UNLOCK_RWLOCK 38
+#define CERRAR_RWLOCK 39
+#define ESPERAS_RWLOCK 40
+//Barreras
+#define CREAR_BARRERA 41
+#define ABRIR_BARRERA 42
+#define ESPERAR_BARRERA 43
+#define CERRAR_BARRERA 44
+//Tomar y soltar juntos un conjunto de mutex
+#define LOCK_MULTIPLE 45
+#define UNLOCK_MULTIPLE 46
+//Variantes que no esperan o esperan con plazo
+#define TRYLOCK 47
+#define LOCK_TIMEOUT 48
+#define INTENTAR_CREAR_MUTEX 49
+#define LEER_CARACTER_TIMEOUT 50
+//Prorroga de la rodaja
+#define APLAZAR_EXPULSION 51
+#define PRORROGAS 52
+//Caracteres del terminal perdidos por tener el buffer lleno
+#define CARACTERES_PERDIDOS 53
+//Lectura de varios caracteres del terminal
+#define LEER 54
+//Dispositivos de caracteres
+#define ABRIR_DISPOSITIVO 55
+#define LEER_DISPOSITIVO 56
+#define ESCRIBIR_DISPOSITIVO 57
+#define SONDEAR_DISPOSITIVO 58
+#define CERRAR_DISPOSITIVO 59
+//Lectura del registro de la consola del nucleo
+#define LEER_LOG 60
+//Nivel de los mensajes del nucleo que se muestran
+#define FIJAR_UMBRAL_LOG 61
+//Escritura de varios trozos de texto en una llamada
+#define ESCRIBIRV 62
 
 #endif /* _LLAMSIS_H */
 
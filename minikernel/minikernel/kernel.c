@@ -1,7 +1,7 @@
 /*
  *  kernel/kernel.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
  *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
  *
@@ -15,6 +15,8 @@
 
 #include "kernel.h"	/* Contiene defs. usadas por este modulo */
 #include "string.h"
+#include <stdarg.h>
+#include <stdio.h>
 
 /*
  *
@@ -24,7 +26,7 @@
  */
 
 /*
- * Funcin que inicia la tabla de procesos
+ * Función que inicia la tabla de procesos
  */
 static void iniciar_tabla_proc(){
 	int i;
@@ -34,7 +36,7 @@ static void iniciar_tabla_proc(){
 }
 
 /*
- * Funcin que busca una entrada libre en la tabla de procesos
+ * Función que busca una entrada libre en la tabla de procesos
  */
 static int buscar_BCP_libre(){
 	int i;
@@ -48,7 +50,11 @@ static int buscar_BCP_libre(){
 /*
  *
  * Funciones que facilitan el manejo de las listas de BCPs
- *	insertar_ultimo eliminar_primero eliminar_elem
+ *	insertar_ultimo insertar_primero eliminar_primero eliminar_elem
+ *	concatenar
+ *
+ * Las listas estan doblemente enlazadas (siguiente/anterior), de modo que
+ * eliminar_elem no tiene que recorrer la lista.
  *
  * NOTA: PRIMERO SE DEBE LLAMAR A eliminar Y LUEGO A insertar
  */
@@ -61,10 +67,24 @@ static void insertar_ultimo(lista_BCPs *lista, BCP * proc){
 		lista->primero= proc;
 	else
 		lista->ultimo->siguiente=proc;
+	proc->anterior=lista->ultimo;
 	lista->ultimo= proc;
 	proc->siguiente=NULL;
 }
 
+/*
+ * Inserta un BCP al principio de la lista.
+ */
+static void insertar_primero(lista_BCPs *lista, BCP * proc){
+	proc->siguiente=lista->primero;
+	proc->anterior=NULL;
+	if (lista->primero==NULL)
+		lista->ultimo= proc;
+	else
+		lista->primero->anterior=proc;
+	lista->primero= proc;
+}
+
 /*
  * Elimina el primer BCP de la lista.
  */
@@ -72,31 +92,207 @@ static void eliminar_primero(lista_BCPs *lista){
 	if (lista->ultimo==lista->primero)
 		lista->ultimo=NULL;
 	lista->primero=lista->primero->siguiente;
+	if (lista->primero)
+		lista->primero->anterior=NULL;
 }
 
 /*
- * Elimina un determinado BCP de la lista.
+ * Elimina un determinado BCP de la lista, que debe estar en ella.
  */
 static void eliminar_elem(lista_BCPs *lista, BCP * proc){
-	BCP *paux=lista->primero;
+	if (proc->anterior)
+		proc->anterior->siguiente=proc->siguiente;
+	else
+		lista->primero=proc->siguiente;
+	if (proc->siguiente)
+		proc->siguiente->anterior=proc->anterior;
+	else
+		lista->ultimo=proc->anterior;
+}
 
-	if (paux==proc)
-		eliminar_primero(lista);
-	else {
-		for ( ; ((paux) && (paux->siguiente!=proc));
-			paux=paux->siguiente);
-		if (paux) {
-			if (lista->ultimo==paux->siguiente)
-				lista->ultimo=paux;
-			paux->siguiente=paux->siguiente->siguiente;
-		}
+/*
+ * Añade todos los BCPs de la lista origen al final de la lista destino,
+ * dejando vacia la lista origen.
+ */
+static void concatenar(lista_BCPs *destino, lista_BCPs *origen){
+	if (origen->primero==NULL)
+		return;
+	if (destino->primero==NULL)
+		destino->primero=origen->primero;
+	else
+		destino->ultimo->siguiente=origen->primero;
+	origen->primero->anterior=destino->ultimo;
+	destino->ultimo=origen->ultimo;
+	origen->primero=origen->ultimo=NULL;
+}
+
+/*
+ *
+ * Funciones que facilitan el manejo de los monticulos de BCPs
+ *	insertar_monticulo extraer_minimo eliminar_monticulo
+ *
+ * Es un monticulo de emparejamiento: la raiz tiene la menor clave y cada
+ * nodo guarda su primer hijo, su siguiente hermano y el nodo anterior, asi
+ * que no necesita memoria aparte de los enlaces del BCP.
+ */
+
+/*
+ * Une dos monticulos y devuelve la nueva raiz. Con claves iguales gana
+ * el primero, de modo que los empates se resuelven por orden de llegada.
+ */
+static BCP * fusionar(BCP * a, BCP * b){
+	BCP *aux;
+
+	if (a==NULL)
+		return b;
+	if (b==NULL)
+		return a;
+	if (b->clave < a->clave){
+		aux=a; a=b; b=aux;
+	}
+	b->hermano=a->hijo;
+	if (b->hermano)
+		b->hermano->ant_mont=b;
+	b->ant_mont=a;
+	a->hijo=b;
+	return a;
+}
+
+/*
+ * Fusiona por parejas la lista de hermanos que empieza en proc (primera
+ * pasada de izquierda a derecha y segunda en sentido contrario).
+ */
+static BCP * fusionar_pares(BCP * proc){
+	BCP *segundo, *resto;
+
+	if (proc==NULL || proc->hermano==NULL)
+		return proc;
+	segundo=proc->hermano;
+	resto=segundo->hermano;
+	proc->hermano=segundo->hermano=NULL;
+	return fusionar(fusionar(proc, segundo), fusionar_pares(resto));
+}
+
+/*
+ * Inserta un BCP en el monticulo segun su clave.
+ */
+static void insertar_monticulo(monticulo_BCPs *mont, BCP * proc){
+	proc->hijo=proc->hermano=NULL;
+	mont->raiz=fusionar(mont->raiz, proc);
+	mont->raiz->ant_mont=NULL;
+}
+
+/*
+ * Extrae el BCP de menor clave del monticulo.
+ */
+static BCP * extraer_minimo(monticulo_BCPs *mont){
+	BCP *proc=mont->raiz;
+
+	mont->raiz=fusionar_pares(proc->hijo);
+	if (mont->raiz)
+		mont->raiz->ant_mont=NULL;
+	proc->hijo=NULL;
+	return proc;
+}
+
+/*
+ * Saca del monticulo un BCP cualquiera, por ejemplo para volver a
+ * insertarlo con otra clave. Se desengancha su subarbol y los hijos,
+ * emparejados, se funden con el resto.
+ */
+static void eliminar_monticulo(monticulo_BCPs *mont, BCP * proc){
+	BCP *hijos;
+
+	if (proc==mont->raiz){
+		extraer_minimo(mont);
+		return;
+	}
+	if (proc->ant_mont->hijo==proc)
+		proc->ant_mont->hijo=proc->hermano;
+	else
+		proc->ant_mont->hermano=proc->hermano;
+	if (proc->hermano)
+		proc->hermano->ant_mont=proc->ant_mont;
+	hijos=fusionar_pares(proc->hijo);
+	proc->hijo=proc->hermano=NULL;
+	mont->raiz=fusionar(mont->raiz, hijos);
+	mont->raiz->ant_mont=NULL;
+}
+
+/*
+ *
+ * Consola del nucleo
+ *
+ */
+
+//Vuelca en pantalla lo pendiente de la consola, en un trozo o en dos si
+//da la vuelta al buffer. Se llama con las interrupciones inhibidas
+static void volcar_consola(){
+	unsigned int inicio, n;
+
+	while(volcado_consola != cola_consola){
+		inicio = volcado_consola & (TAM_CONSOLA-1);
+		n = cola_consola - volcado_consola;
+		if(n > TAM_CONSOLA - inicio)
+			n = TAM_CONSOLA - inicio;
+		escribir_ker(&buffer_consola[inicio], n);
+		volcado_consola += n;
+	}
+}
+
+//Anade el texto a la consola, volcandola si lo pendiente llega a la marca
+static void escribir_consola(const char *texto, unsigned int n){
+	unsigned int libres, trozo;
+	int nivel;
+
+	nivel=fijar_nivel_int(NIVEL_3);
+	while(n > 0){
+		if(cola_consola - volcado_consola >= MARCA_CONSOLA)
+			volcar_consola();
+		libres = TAM_CONSOLA - (cola_consola - volcado_consola);
+		trozo = n < libres ? n : libres;
+		n -= trozo;
+		while(trozo-- > 0)
+			buffer_consola[cola_consola++ & (TAM_CONSOLA-1)] = *texto++;
 	}
+	if(cola_consola - volcado_consola >= MARCA_CONSOLA)
+		volcar_consola();
+	fijar_nivel_int(nivel);
+}
+
+//printk del nucleo: formatea el mensaje y lo deja en la consola
+int printk_consola(const char *formato, ...){
+	char texto[TAM_LINEA_CONSOLA];
+	va_list args;
+	int n;
+
+	va_start(args, formato);
+	n=vsnprintf(texto, sizeof(texto), formato, args);
+	va_end(args);
+	if(n < 0)
+		return n;
+	if(n >= (int)sizeof(texto))
+		n=sizeof(texto)-1;
+	escribir_consola(texto, n);
+	return n;
+}
+
+//panico del nucleo: vuelca la consola para que no se pierda lo anterior
+//al fallo y despues muestra el mensaje y para con el panico del HAL
+void panico_consola(char *mens){
+	fijar_nivel_int(NIVEL_3);
+	volcar_consola();
+	(panico)(mens);
 }
 
 /*
  *
  * Funciones relacionadas con la planificacion
- *	espera_int planificador
+ *	espera_int insertar_listo extraer_listo planificador
+ *	comprobar_expropiacion desbloquear cambio_proc
+ *	subir_nivel_mlfq reiniciar_niveles_mlfq
+ *	actualizar_vruntime limitar_vruntime actualizar_pase
+ *	ajustar_edf
  */
 
 /*
@@ -105,31 +301,367 @@ static void eliminar_elem(lista_BCPs *lista, BCP * proc){
 static void espera_int(){
 	int nivel;
 
-	printk("-> NO HAY LISTOS. ESPERA INT\n");
+	printk_traza("-> NO HAY LISTOS. ESPERA INT\n");
+	//Sin nada que ejecutar es el momento de volcar la consola
+	volcar_consola();
 
-	/* Baja al mnimo el nivel de interrupcin mientras espera */
+	/* Baja al mínimo el nivel de interrupción mientras espera */
+	esperando_int=1;
 	nivel=fijar_nivel_int(NIVEL_1);
 	halt();
 	fijar_nivel_int(nivel);
+	esperando_int=0;
+}
+
+/*
+ * Inserta un proceso en la cola de listos de su prioridad y marca la
+ * cola como no vacia en el mapa. Un proceso expulsado antes de agotar
+ * su rodaja se inserta al principio para que no pierda su turno.
+ * En CFS y stride se inserta en el monticulo de listos por su vruntime
+ * o su pase respectivamente. Los procesos EDF van siempre a su propio
+ * monticulo, ordenado por plazo absoluto.
+ */
+static void insertar_listo(BCP * proc, int al_principio){
+	n_listos++;
+	if (proc->edf){
+		proc->clave=proc->plazo_absoluto;
+		insertar_monticulo(&monticulo_edf, proc);
+		return;
+	}
+	if (USA_MONTICULO){
+		if (POLITICA_PLANIF==PLANIF_CFS){
+			proc->clave=proc->vruntime;
+			peso_listos+=pesos_cfs[proc->prioridad];
+		}
+		else
+			proc->clave=proc->pase;
+		insertar_monticulo(&monticulo_listos, proc);
+		return;
+	}
+
+	if (al_principio)
+		insertar_primero(&lista_listos[proc->prioridad], proc);
+	else
+		insertar_ultimo(&lista_listos[proc->prioridad], proc);
+	mapa_listos |= (1U << proc->prioridad);
+}
+
+/*
+ * Extrae el primer proceso de la cola de mayor prioridad no vacia.
+ * El bit mas significativo del mapa indica la cola, por lo que la
+ * eleccion no depende del numero de procesos listos. Los procesos EDF
+ * listos tienen preferencia sobre todos los demas.
+ */
+static BCP * extraer_listo(){
+	int prio;
+	BCP *proc;
+
+	n_listos--;
+	if (monticulo_edf.raiz!=NULL)
+		return extraer_minimo(&monticulo_edf);
+	if (USA_MONTICULO){
+		proc=extraer_minimo(&monticulo_listos);
+		if (POLITICA_PLANIF==PLANIF_CFS)
+			peso_listos-=pesos_cfs[proc->prioridad];
+		return proc;
+	}
+
+	prio=31-__builtin_clz(mapa_listos);
+	proc=lista_listos[prio].primero;
+	eliminar_primero(&lista_listos[prio]);
+	if (lista_listos[prio].primero==NULL)
+		mapa_listos &= ~(1U << prio);
+	return proc;
+}
+
+/*
+ * Devuelve la prioridad del proceso listo mas prioritario, o -1 si
+ * no hay ninguno.
+ */
+static int max_prioridad_lista(){
+	if (mapa_listos==0)
+		return -1;
+	return 31-__builtin_clz(mapa_listos);
+}
+
+/*
+ * Devuelve la rodaja que corresponde al proceso: en MLFQ depende del
+ * nivel en el que esta, en CFS de la parte de LATENCIA_CFS que le toca
+ * por su peso y en otro caso es fija.
+ */
+static unsigned int rodaja_proceso(BCP * proc){
+	int peso;
+	unsigned int rodaja;
+
+	if (POLITICA_PLANIF==PLANIF_MLFQ)
+		return rodajas_mlfq[proc->prioridad];
+	if (POLITICA_PLANIF==PLANIF_CFS){
+		peso=pesos_cfs[proc->prioridad];
+		rodaja=LATENCIA_CFS*peso/(peso_listos+peso);
+		if (rodaja < GRANULARIDAD_CFS)
+			rodaja=GRANULARIDAD_CFS;
+		return rodaja;
+	}
+	return TICKS_POR_RODAJA;
 }
 
 /*
- * Funcin de planificacion que implementa un algoritmo FIFO.
+ * Función de planificacion por prioridades, FIFO dentro de cada una.
+ * Saca de las colas de listos al proceso elegido.
  */
 static BCP * planificador(){
-	while (lista_listos.primero==NULL)
+	BCP *proceso;
+
+	while (n_listos==0)
 		espera_int();		/* No hay nada que hacer */
-		
+
 	//Asigna el tiempo de la rodaja al proceso
-	BCP *proceso = lista_listos.primero;
-	proceso->rodaja = TICKS_POR_RODAJA;
-	
-	return lista_listos.primero;
+	proceso = extraer_listo();
+	proceso->rodaja = rodaja_proceso(proceso);
+
+	//Contabiliza lo que ha esperado desde que le despertaron
+	if (proceso->instante_listo >= 0){
+		proceso->latencia_total += n_interrup - proceso->instante_listo;
+		proceso->n_despertares++;
+		proceso->instante_listo = -1;
+	}
+
+	return proceso;
+}
+
+/*
+ * Si el proceso que acaba de pasar a listo es mas prioritario que el
+ * que esta en ejecucion, solicita una interrupcion software para
+ * expulsarlo.
+ */
+static void comprobar_expropiacion(BCP * proc){
+	if (esperando_int || p_proc_actual->estado!=LISTO)
+		return;
+	//EDF expulsa a cualquier proceso normal y a los EDF de plazo posterior
+	if (proc->edf || p_proc_actual->edf){
+		if (proc->edf && (!p_proc_actual->edf ||
+		    proc->plazo_absoluto < p_proc_actual->plazo_absoluto)){
+			replanificacion_pendiente=1;
+			activar_int_SW();
+		}
+		return;
+	}
+	if (POLITICA_PLANIF==PLANIF_CFS){
+		if (proc->vruntime + GRANULARIDAD_DESPERTAR_CFS*PESO_BASE < p_proc_actual->vruntime){
+			replanificacion_pendiente=1;
+			activar_int_SW();
+		}
+	}
+	else if (POLITICA_PLANIF==PLANIF_STRIDE){
+		if (proc->pase < p_proc_actual->pase){
+			replanificacion_pendiente=1;
+			activar_int_SW();
+		}
+	}
+	else if (proc->prioridad > p_proc_actual->prioridad){
+		replanificacion_pendiente=1;
+		activar_int_SW();
+	}
+}
+
+//CFS: un proceso que ha estado bloqueado vuelve como mucho con
+//CREDITO_DORMIDO_CFS ticks de ventaja sobre min_vruntime, para que no
+//acumule credito ilimitado mientras duerme
+static void limitar_vruntime(BCP * proc){
+	unsigned long long credito=(unsigned long long)CREDITO_DORMIDO_CFS*PESO_BASE;
+
+	if (min_vruntime > credito && proc->vruntime < min_vruntime-credito)
+		proc->vruntime=min_vruntime-credito;
+}
+
+//CFS: carga un tick al proceso en ejecucion segun su peso y hace avanzar
+//min_vruntime, que nunca retrocede
+static void actualizar_vruntime(BCP * proc){
+	unsigned long long minimo;
+
+	proc->vruntime+=(unsigned long long)PESO_BASE*PESO_BASE/pesos_cfs[proc->prioridad];
+
+	minimo=proc->vruntime;
+	if (monticulo_listos.raiz!=NULL && monticulo_listos.raiz->vruntime < minimo)
+		minimo=monticulo_listos.raiz->vruntime;
+	if (minimo > min_vruntime)
+		min_vruntime=minimo;
+}
+
+//Stride: carga un tick al proceso en ejecucion sumando su zancada a su
+//pase y hace avanzar pase_global, que nunca retrocede
+static void actualizar_pase(BCP * proc){
+	unsigned long long minimo;
+
+	proc->pase+=proc->zancada;
+
+	minimo=proc->pase;
+	if (monticulo_listos.raiz!=NULL && monticulo_listos.raiz->pase < minimo)
+		minimo=monticulo_listos.raiz->pase;
+	if (minimo > pase_global)
+		pase_global=minimo;
+}
+
+//Definida junto a la rueda de dormidos
+static void eliminar_rueda(BCP * proc);
+
+//Pasa a listo un proceso que ya no esta en ninguna lista de espera y lo
+//inserta en la cola de listos que le corresponde, sin comprobar si debe
+//expulsar al actual. Si esperaba con plazo se le quita de la rueda. Se
+//llama con las interrupciones inhibidas
+static void poner_listo(BCP * proc){
+        if (proc->espera_con_plazo){
+                eliminar_rueda(proc);
+                proc->espera_con_plazo=NULL;
+        }
+	//Ponemos el proceso en estado listo
+        proc->estado=LISTO;
+        proc->instante_listo=n_interrup;
+        //EDF: vuelve con trabajo del periodo actual
+        proc->pendiente=1;
+        if (POLITICA_PLANIF==PLANIF_CFS)
+                limitar_vruntime(proc);
+        //Stride: mientras estaba bloqueado no compite, asi que no
+        //puede volver con un pase anterior al del resto
+        if (POLITICA_PLANIF==PLANIF_STRIDE && proc->pase < pase_global)
+                proc->pase=pase_global;
+	//Y lo insertamos en la cola de listos que le corresponde
+        insertar_listo(proc, 0);
+}
+
+//Funcion para desbloquear un proceso, lo saca de la lista de espera
+//(si se indica) y lo inserta en la cola de listos de su prioridad
+static void desbloquear(BCP * proc, lista_BCPs *lista){
+        int nivel;
+
+        nivel=fijar_nivel_int(NIVEL_3);
+	//De la lista espera eliminamos el proceso ya listo
+        if (lista)
+                eliminar_elem(lista, proc);
+        poner_listo(proc);
+        comprobar_expropiacion(proc);
+        fijar_nivel_int(nivel);
+}
+
+//Prioridad que le corresponde al proceso: la propia o la heredada si es mayor
+static int prioridad_efectiva(BCP * proc){
+	if (proc->prioridad_heredada > proc->prioridad_base)
+		return proc->prioridad_heredada;
+	return proc->prioridad_base;
+}
+
+//Cambia la prioridad efectiva de un proceso. Si esta en una cola de listos
+//se le pasa a la de su nueva prioridad y si esta en ejecucion y baja se
+//comprueba si debe cederla. En CFS solo cambia el peso de los listos y en
+//stride y EDF la prioridad no interviene en la eleccion. Las colas de
+//listos las modifica tambien int_reloj, asi que se trabaja a nivel 3
+static void aplicar_prioridad(BCP * proc, int prioridad){
+	int anterior=proc->prioridad;
+	int nivel;
+
+	if (prioridad==anterior)
+		return;
+	nivel=fijar_nivel_int(NIVEL_3);
+	if (proc!=p_proc_actual && proc->estado==LISTO && !proc->edf){
+		if (POLITICA_PLANIF==PLANIF_CFS)
+			peso_listos+=pesos_cfs[prioridad]-pesos_cfs[anterior];
+		else if (!USA_MONTICULO){
+			eliminar_elem(&lista_listos[anterior], proc);
+			if (lista_listos[anterior].primero==NULL)
+				mapa_listos &= ~(1U << anterior);
+			n_listos--;
+			proc->prioridad=prioridad;
+			insertar_listo(proc, 0);
+		}
+		proc->prioridad=prioridad;
+		comprobar_expropiacion(proc);
+		fijar_nivel_int(nivel);
+		return;
+	}
+	proc->prioridad=prioridad;
+	if (proc==p_proc_actual && !USA_MONTICULO && max_prioridad_lista() > prioridad){
+		replanificacion_pendiente=1;
+		activar_int_SW();
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Recalcula la prioridad que hereda un proceso de los que esperan los mutex
+//de los que es propietario y la aplica. Si el proceso espera a su vez otro
+//mutex el cambio se propaga al propietario de este, y asi sucesivamente
+//(herencia transitiva), hasta que uno no cambia de prioridad. Se recorre
+//con el reloj inhibido porque saca de las colas a los que vencen su plazo
+static void recalcular_prioridad(BCP * proc){
+	int i, heredada, nueva, nivel;
+	BCP * esperando;
+
+	nivel=fijar_nivel_int(NIVEL_3);
+	while (proc){
+		heredada=-1;
+		for (i=0; i<NUM_MUT; i++){
+			if (array_mutex[i].bloqueado==0 || array_mutex[i].propietario!=proc->id)
+				continue;
+			for (esperando=array_mutex[i].lista_espera.primero; esperando; esperando=esperando->siguiente)
+				if (esperando->prioridad > heredada)
+					heredada=esperando->prioridad;
+		}
+		proc->prioridad_heredada=heredada;
+		nueva=prioridad_efectiva(proc);
+		if (nueva==proc->prioridad)
+			break;
+		if (nueva > proc->prioridad){
+			herencias_prioridad++;
+			printk_depuracion("-> PROC %d: HEREDA PRIORIDAD %d\n", proc->id, nueva);
+		}
+		aplicar_prioridad(proc, nueva);
+
+		if (proc->estado==BLOQUEADO && proc->mutex_esperado)
+			proc=&tabla_procs[proc->mutex_esperado->propietario];
+		else
+			proc=NULL;
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Indica si el proceso es propietario de algun mutex. La prorroga se da
+//aunque nadie lo espere todavia: lo que se quiere evitar es que se le
+//expulse con el mutex tomado, porque cualquiera de los listos puede
+//pedirlo justo despues y tendria que bloquearse hasta que vuelva a
+//ejecutar y lo suelte
+static int tiene_mutex(BCP * proc){
+	int i;
+
+	for (i=0; i<NUM_MUT; i++)
+		if (array_mutex[i].bloqueado && array_mutex[i].propietario==proc->id)
+			return 1;
+	return 0;
 }
 
+//Acaba la prorroga de un proceso y contabiliza lo que ha durado
+static void terminar_prorroga(BCP * proc){
+	ticks_prorroga+=n_interrup-proc->inicio_prorroga;
+	proc->en_prorroga=0;
+}
+
+//Si el proceso actual esta en prorroga y ya no la necesita, porque no
+//tiene mutex ni ha pedido que se aplace su expulsion, la deja y
+//cede el procesador como si se le hubiese acabado la rodaja
+static void ceder_prorroga(){
+	if (!p_proc_actual->en_prorroga || p_proc_actual->aplazar_expulsion ||
+	    tiene_mutex(p_proc_actual))
+		return;
+	terminar_prorroga(p_proc_actual);
+	prorrogas_cedidas++;
+	p_proc_actual->rodaja=0;
+	replanificacion_pendiente=1;
+	activar_int_SW();
+}
 
 //Objetivo parcial 4, round robin
-//Funcin que realiza un cambio de proceso ya sea voluntario o involuntario
+//Función que realiza un cambio de proceso ya sea voluntario o involuntario.
+//El estado del proceso actual decide a donde va: si sigue LISTO vuelve a su
+//cola de listos, si esta BLOQUEADO se inserta en la lista destino (si la hay)
+//y si ha TERMINADO no se inserta en ninguna.
 static void cambio_proc(lista_BCPs *lista_destino) {
         //Declaramos el puntero al proceso anterior un contexto auxiliar y un nivel
 	BCP * p_proc_anterior;
@@ -140,23 +672,27 @@ static void cambio_proc(lista_BCPs *lista_destino) {
 	p_proc_anterior=p_proc_actual;
 	nivel=fijar_nivel_int(NIVEL_3);
 
-	//El proceso no sigue. En caso de replanificacin pendiente desactivar proceso
+	//Ya se atiende la replanificación pendiente, si la habia
 	replanificacion_pendiente=0;
-	eliminar_primero(&lista_listos);
+	//Si deja el procesador en prorroga, esta acaba aqui
+	if (p_proc_anterior->en_prorroga)
+		terminar_prorroga(p_proc_anterior);
 
-	//Si se ha especificado una lista destino para el BCP, se inserta.
-	if (lista_destino){
-		insertar_ultimo(lista_destino, p_proc_anterior);
-		if (lista_destino != &lista_listos){
-			p_proc_actual->estado=BLOQUEADO;
+	if (p_proc_anterior->estado==LISTO){
+		//Si se le expulsa sin haber agotado la rodaja conserva su turno
+		insertar_listo(p_proc_anterior, p_proc_anterior->rodaja>0);
+	}
+	else if (p_proc_anterior->estado==BLOQUEADO){
+		//EDF: si se bloquea por si mismo ha terminado el trabajo del periodo
+		if (lista_destino!=&lista_edf_agotados)
+			p_proc_anterior->pendiente=0;
+		if (lista_destino){
+			insertar_ultimo(lista_destino, p_proc_anterior);
+			printk_traza("identificador del proceso:  %d\n",p_proc_actual->id);
 		}
-		printk("identificador del proceso:  %d\n",p_proc_actual->id);
 	}
-		
-	p_proc_actual=planificador();
 
-	//Se asigna una rodaja completa al proceso que va a ejecutar
-	p_proc_actual->rodaja=TICKS_POR_RODAJA;
+	p_proc_actual=planificador();
 
 	//Si el proceso ya ha terminado, no se salva y se libera la pila 
 	if (p_proc_anterior->estado==TERMINADO){
@@ -171,6 +707,77 @@ static void cambio_proc(lista_BCPs *lista_destino) {
 	fijar_nivel_int(nivel);
 }
 
+//EDF: en cada tick activa los procesos EDF que empiezan periodo, con
+//presupuesto nuevo y plazo absoluto, desbloqueando a los que lo habian
+//agotado, y cuenta como fallo cada trabajo que llega a su plazo sin
+//haber terminado ni consumido su presupuesto. El plazo absoluto es la
+//clave del monticulo EDF, asi que el que esta en el se saca y se vuelve a
+//meter con el nuevo
+static void ajustar_edf(){
+	int i, en_monticulo;
+	BCP *proc;
+
+	for (i=0; i<MAX_PROC; i++){
+		proc=&tabla_procs[i];
+		if (proc->estado==NO_USADA || !proc->edf)
+			continue;
+
+		if (proc->pendiente && proc->presupuesto_restante>0 &&
+		    n_interrup >= proc->plazo_absoluto){
+			proc->fallos_plazo++;
+			proc->pendiente=0;
+			printk_aviso("-> PROC %d: FALLO DE PLAZO EDF (%d)\n", proc->id, proc->fallos_plazo);
+		}
+
+		if (n_interrup >= proc->siguiente_activacion){
+			en_monticulo=(proc!=p_proc_actual && proc->estado==LISTO);
+			if (en_monticulo)
+				eliminar_monticulo(&monticulo_edf, proc);
+			proc->plazo_absoluto=proc->siguiente_activacion+proc->plazo_relativo;
+			if (en_monticulo){
+				proc->clave=proc->plazo_absoluto;
+				insertar_monticulo(&monticulo_edf, proc);
+			}
+			proc->siguiente_activacion+=proc->periodo;
+			proc->presupuesto_restante=proc->presupuesto;
+			if (proc->retenido){
+				//Estaba retenido por agotar el presupuesto
+				proc->retenido=0;
+				desbloquear(proc, &lista_edf_agotados);
+			}
+			else if (proc->estado==LISTO)
+				proc->pendiente=1;
+		}
+	}
+}
+
+//MLFQ: el proceso actual va a bloquearse esperando un evento, por lo que
+//se le considera interactivo y sube un nivel
+static void subir_nivel_mlfq(){
+	if (POLITICA_PLANIF==PLANIF_MLFQ && p_proc_actual->prioridad_base < PRIO_MAX){
+		p_proc_actual->prioridad_base++;
+		p_proc_actual->prioridad=prioridad_efectiva(p_proc_actual);
+	}
+}
+
+//MLFQ: sube todos los procesos al nivel maximo para que los que han ido
+//bajando por consumir CPU no sufran inanicion. Las colas se enlazan de
+//mayor a menor nivel, por lo que se conserva el orden relativo
+static void reiniciar_niveles_mlfq(){
+	int i;
+
+	for (i=PRIO_MAX-1; i>=PRIO_MIN; i--)
+		concatenar(&lista_listos[PRIO_MAX], &lista_listos[i]);
+	if (lista_listos[PRIO_MAX].primero!=NULL)
+		mapa_listos = (1U << PRIO_MAX);
+
+	for (i=0; i<MAX_PROC; i++)
+		if (tabla_procs[i].estado!=NO_USADA)
+			tabla_procs[i].prioridad_base=tabla_procs[i].prioridad=PRIO_MAX;
+}
+
+//Definida junto a los servicios de mutex y semaforos
+static void cerrar_descriptores();
 
 /*
  *
@@ -180,30 +787,46 @@ static void cambio_proc(lista_BCPs *lista_destino) {
  */
 static void liberar_proceso(){
 	BCP * p_proc_anterior;
+	int nivel;
 	
-	if(p_proc_actual->numeroMutex!=0){
-	       sis_cerrar_mutex(p_proc_actual);
-	}
+	//Cierre implicito de los mutex y semaforos que siga teniendo abiertos
+	cerrar_descriptores();
+
+	//Al liberar la imagen del ultimo proceso el HAL para la maquina, asi
+	//que antes hay que volcar la consola
+	nivel=fijar_nivel_int(NIVEL_3);
+	volcar_consola();
+	fijar_nivel_int(nivel);
 	       
 	liberar_imagen(p_proc_actual->info_mem); /* liberar mapa */
 
 	p_proc_actual->estado=TERMINADO;
+
+	//EDF: libera la utilizacion que tenia reservada
+	if (p_proc_actual->edf){
+		utilizacion_edf -= p_proc_actual->utilizacion;
+		printk_info("-> PROC %d: %d FALLOS DE PLAZO EDF\n", p_proc_actual->id, p_proc_actual->fallos_plazo);
+	}
+
+	if (p_proc_actual->n_despertares > 0)
+		printk_info("-> PROC %d: LATENCIA MEDIA AL DESPERTAR %d ticks (%d despertares)\n",
+			p_proc_actual->id,
+			p_proc_actual->latencia_total/p_proc_actual->n_despertares,
+			p_proc_actual->n_despertares);
         
         //fijar_nivel_int(NIVEL_3);
 
-	eliminar_primero(&lista_listos); /* proc. fuera de listos */
-
 	/* Realizar cambio de contexto */
 	p_proc_anterior=p_proc_actual;
 	p_proc_actual=planificador();
 
-	printk("-> C.CONTEXTO POR FIN: de %d a %d\n",
+	printk_traza("-> C.CONTEXTO POR FIN: de %d a %d\n",
 			p_proc_anterior->id, p_proc_actual->id);
 
 	liberar_pila(p_proc_anterior->pila);
 	cambio_contexto(NULL, &(p_proc_actual->contexto_regs));
 	
-        return; /* no debera llegar aqui */
+        return; /* no debería llegar aqui */
 }
 
 
@@ -227,10 +850,10 @@ static void exc_arit(){
 		panico("excepcion aritmetica cuando estaba dentro del kernel");
 
 
-	printk("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
+	printk_aviso("-> EXCEPCION ARITMETICA EN PROC %d\n", p_proc_actual->id);
 	liberar_proceso();
 
-        return; /* no debera llegar aqui */
+        return; /* no debería llegar aqui */
 }
 
 /*
@@ -242,10 +865,34 @@ static void exc_mem(){
 		panico("excepcion de memoria cuando estaba dentro del kernel");
 
 
-	printk("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
+	printk_aviso("-> EXCEPCION DE MEMORIA EN PROC %d\n", p_proc_actual->id);
 	liberar_proceso();
 
-        return; /* no debera llegar aqui */
+        return; /* no debería llegar aqui */
+}
+
+//Indica si al proceso le basta lo que hay en el buffer del terminal: al
+//que lee en modo canonico una linea completa o lectura_minima caracteres,
+//y al resto cualquier caracter
+static int lectura_lista(BCP * proc){
+	unsigned int disponibles = cola_terminal - cabeza_terminal;
+
+	if(proc->lectura_canonica)
+		return lineas_terminal > 0 || disponibles >= proc->lectura_minima;
+	return disponibles > 0;
+}
+
+//Despierta al primer lector que espera si ya tiene lo que necesita. Solo
+//se mira al primero, asi que cuesta O(1) y se respeta el orden de llegada.
+//Se elige con el reloj inhibido, porque puede sacar de la lista a un
+//lector cuyo plazo vence
+static void despertar_lector(){
+	int nivel;
+
+	nivel=fijar_nivel_int(NIVEL_3);
+	if(lista_lectores.primero != NULL && lectura_lista(lista_lectores.primero))
+		desbloquear(lista_lectores.primero, &lista_lectores);
+	fijar_nivel_int(nivel);
 }
 
 /*
@@ -255,62 +902,84 @@ static void int_terminal(){
 	char car;
 	
 	car = leer_puerto(DIR_TERMINAL);
-	printk("-> TRATANDO INT. DE TERMINAL %c\n", car);
+	printk_traza("-> TRATANDO INT. DE TERMINAL %c\n", car);
+
+	//En modo canonico se edita aqui la linea en curso, que empieza en
+	//inicio_linea_terminal salvo que algun lector ya haya sacado parte
+	if(canonico_terminal){
+		if((int)(cabeza_terminal - inicio_linea_terminal) > 0)
+			inicio_linea_terminal = cabeza_terminal;
+		if(car == CAR_BORRAR || car == CAR_RETROCESO){
+			if(cola_terminal != inicio_linea_terminal)
+				cola_terminal--;
+			return;
+		}
+		if(car == CAR_BORRAR_LINEA){
+			cola_terminal = inicio_linea_terminal;
+			return;
+		}
+		if(car == '\r')
+			car = '\n';
+	}
 
 	//Objetivo parcial 5 
-        //Si el buffer no est lleno introduce el caracter nuevo
-	if(BufferChar < TAM_BUF_TERM){
-		Buffer[BufferChar] = car;
-		BufferChar++;		
-
-		//Desbloquea el primer proceso bloqueado por lectura
-		BCP *proceso_bloqueado = lista_de_bloqueados.primero;
-	        
-		//Al principio esta bloqueado
-		int desbloqueado = 0;
-		if (proceso_bloqueado != NULL){
-			if(proceso_bloqueado->blocLectura == 1){
-				//Desbloquea el proceso
-				desbloqueado = 1;
-				//El proceso bloqueado ahora esta listo
-				proceso_bloqueado->estado = LISTO;
-				proceso_bloqueado->blocLectura = 0;
-				//Cambio de contexto
-				int nivel_interrupciones = fijar_nivel_int(NIVEL_3);
-				eliminar_elem(&lista_de_bloqueados, proceso_bloqueado);
-				insertar_ultimo(&lista_listos, proceso_bloqueado);
-				fijar_nivel_int(nivel_interrupciones);
-			}
-		}
-		
-		//Mientras no este desbloqueado y el ultimo de la lista de dormidos no este bloqueado
-		while(desbloqueado != 1 && proceso_bloqueado != lista_de_bloqueados.ultimo){
-			proceso_bloqueado = proceso_bloqueado->siguiente;
-			if(proceso_bloqueado->blocLectura == 1){
-				//Desbloquea el proceso
-				desbloqueado = 1;
-				//El proceso bloqueado ahora esta listo
-				proceso_bloqueado->estado = LISTO;
-				proceso_bloqueado->blocLectura = 0;
-				//Cambio de contexto
-				int nivel_interrupciones = fijar_nivel_int(NIVEL_3);
-				eliminar_elem(&lista_de_bloqueados, proceso_bloqueado);
-				insertar_ultimo(&lista_listos, proceso_bloqueado);
-				fijar_nivel_int(nivel_interrupciones);
-			}
+	//Si el buffer no esta lleno introduce el caracter nuevo al final
+	if(cola_terminal - cabeza_terminal < TAM_BUF_TERMINAL){
+		buffer_terminal[cola_terminal & MASCARA_BUF_TERMINAL] = car;
+		cola_terminal++;
+		//Una linea completa ya no se puede editar
+		if(car == '\n'){
+			lineas_terminal++;
+			inicio_linea_terminal = cola_terminal;
 		}
-	}	
+		else if(!canonico_terminal)
+			inicio_linea_terminal = cola_terminal;
+
+		despertar_lector();
+	}
+	else{
+		perdidos_terminal++;
+		printk_aviso("-> CARACTER PERDIDO: BUFFER DEL TERMINAL LLENO\n");
+	}
 	
 	return;
 }
 
 //Objetivo parcial 4, Round robin
-//Funcin auxiliar que actualiza la rodaja y si detecta su terminacin activa una interrupcin software
+//Función auxiliar que actualiza la rodaja y si detecta su terminación activa una interrupción software
 static void ajustar_rodaja() {
-	//Si el proceso no esta listo para ejecutar, no se actualiza la rodaja 
-	if (p_proc_actual->estado == LISTO) {
+	//EDF: no hay rodaja, se consume presupuesto y al agotarlo se le
+	//retiene hasta el siguiente periodo
+	if (!esperando_int && p_proc_actual->estado == LISTO && p_proc_actual->edf) {
+		if (p_proc_actual->presupuesto_restante > 0 &&
+		    --p_proc_actual->presupuesto_restante == 0) {
+			replanificacion_pendiente=1;
+			activar_int_SW();
+		}
+		return;
+	}
+	//Si el proceso no esta listo para ejecutar, no se actualiza la rodaja.
+	//Puede estar ya a 0 si ha cedido una prorroga y aun no se ha atendido
+	if (!esperando_int && p_proc_actual->estado == LISTO && p_proc_actual->rodaja > 0) {
 		p_proc_actual->rodaja--;
 		if (p_proc_actual->rodaja==0) {
+			//Una prorroga no se prorroga: al agotarla se le expulsa
+			if (p_proc_actual->en_prorroga)
+				terminar_prorroga(p_proc_actual);
+			else if (PRORROGA_MUTEX > 0 && (p_proc_actual->aplazar_expulsion ||
+				 tiene_mutex(p_proc_actual))) {
+				printk_depuracion("-> PROC %d: PRORROGA DE RODAJA\n", p_proc_actual->id);
+				p_proc_actual->en_prorroga=1;
+				p_proc_actual->inicio_prorroga=n_interrup;
+				p_proc_actual->rodaja=PRORROGA_MUTEX;
+				prorrogas_concedidas++;
+				return;
+			}
+			//MLFQ: ha consumido toda su rodaja, baja un nivel
+			if (POLITICA_PLANIF==PLANIF_MLFQ && p_proc_actual->prioridad_base > PRIO_MIN){
+				p_proc_actual->prioridad_base--;
+				p_proc_actual->prioridad=prioridad_efectiva(p_proc_actual);
+			}
 			replanificacion_pendiente=1;
 			activar_int_SW();
 		}
@@ -321,13 +990,20 @@ static void ajustar_rodaja() {
  * Tratamiento de interrupciones de reloj
  */
 static void int_reloj(){
-	printk("-> TRATANDO INT. DE RELOJ\n");
+	printk_traza("-> TRATANDO INT. DE RELOJ\n");
 	
 	//Objetivo parcial 3
 	ajustar_rodaja();
 	
         //Objetivo parcial 2
         ajustar_dormidos();
+
+	//EDF: activaciones periodicas y plazos
+	ajustar_edf();
+
+	//MLFQ: reinicio periodico de niveles
+	if (POLITICA_PLANIF==PLANIF_MLFQ && n_interrup % PERIODO_BOOST_MLFQ == 0)
+		reiniciar_niveles_mlfq();
 	
         return;
 }
@@ -352,15 +1028,26 @@ static void tratar_llamsis(){
  */
 static void int_sw(){
 
-	printk("-> TRATANDO INT. SW\n");
+	printk_traza("-> TRATANDO INT. SW\n");
 	
-	cambio_proc(&lista_listos);
+	//Si el proceso ya ha dejado el procesador no queda nada que replanificar
+	if (!replanificacion_pendiente)
+		return;
+	//EDF: si ha agotado el presupuesto queda retenido hasta su siguiente periodo
+	if (p_proc_actual->edf && p_proc_actual->presupuesto_restante==0){
+		printk_depuracion("-> PROC %d: PRESUPUESTO EDF AGOTADO\n", p_proc_actual->id);
+		p_proc_actual->estado=BLOQUEADO;
+		p_proc_actual->retenido=1;
+		cambio_proc(&lista_edf_agotados);
+		return;
+	}
+	cambio_proc(NULL);
 	/*
 	//Objetivo parcial 3
 	//Variable local para id del proceso que va a int sw
         int idABloquear = 0;
 	// Interrupcion SW de planificacion
-	// Comprueba que proceso en ejecucin es el que se quiere bloquear
+	// Comprueba que proceso en ejecución es el que se quiere bloquear
 	if(idABloquear == p_proc_actual->id){
 		//Pone el proceso ejecutando al final de la cola de listos
 		BCP *proceso = lista_listos.primero;
@@ -369,7 +1056,7 @@ static void int_sw(){
 		insertar_ultimo(&lista_listos, proceso);
 		fijar_nivel_int(nivel_interrupciones);
 
-		//Cambio de contexto por int sw de planificacin
+		//Cambio de contexto por int sw de planificación
 		BCP *p_proc_bloqueado = p_proc_actual;
 		p_proc_actual = planificador();
 		cambio_contexto(&(p_proc_bloqueado->contexto_regs), &(p_proc_actual->contexto_regs));
@@ -414,12 +1101,41 @@ static int crear_tarea(char *prog){
 
 		//Inicialmente se asigna una rodaja completa para round robin
 		p_proc->rodaja=TICKS_POR_RODAJA;
-
-		/* Dado que la ruina de int. de reloj tambin manipula la lista
-	   	   de listos, se proh~en las int. en este fragmento */
+		//En MLFQ los procesos nuevos empiezan en el nivel maximo
+		if (POLITICA_PLANIF==PLANIF_MLFQ)
+			p_proc->prioridad=PRIO_MAX;
+		else
+			p_proc->prioridad=PRIO_DEFECTO;
+		p_proc->prioridad_base=p_proc->prioridad;
+		p_proc->prioridad_heredada=-1;
+		p_proc->mutex_esperado=NULL;
+		p_proc->mutex_cond=NULL;
+		p_proc->n_multiple=0;
+		p_proc->espera_con_plazo=NULL;
+		p_proc->aplazar_expulsion=0;
+		p_proc->en_prorroga=0;
+		p_proc->lectura_canonica=0;
+		p_proc->lectura_minima=1;
+		p_proc->instante_listo=-1;
+		p_proc->latencia_total=0;
+		p_proc->n_despertares=0;
+		//En CFS empieza con el menor vruntime actual, sin ventaja acumulada
+		p_proc->vruntime=min_vruntime;
+		//Igual en stride con el pase
+		p_proc->tickets=TICKETS_DEFECTO;
+		p_proc->zancada=ZANCADA_BASE/TICKETS_DEFECTO;
+		p_proc->pase=pase_global;
+		p_proc->edf=0;
+		p_proc->retenido=0;
+		p_proc->fallos_plazo=0;
+		p_proc->holgura=HOLGURA_DEFECTO;
+		p_proc->descriptores_libres=~0U;
+
+		/* Dado que la ruina de int. de reloj también manipula la lista
+	   	   de listos, se prohú~en las int. en este fragmento */
 		nivel=fijar_nivel_int(NIVEL_3);
 		/* lo inserta al final de cola de listos */
-		insertar_ultimo(&lista_listos, p_proc);
+		insertar_listo(p_proc, 0);
 		fijar_nivel_int(nivel);
 		error= 0;
 	}
@@ -444,7 +1160,7 @@ int sis_crear_proceso(){
 	char *prog;
 	int res;
 
-	printk("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
+	printk_info("-> PROC %d: CREAR PROCESO\n", p_proc_actual->id);
 	prog=(char *)leer_registro(1);
 	
 	res=crear_tarea(prog);
@@ -452,8 +1168,8 @@ int sis_crear_proceso(){
 }
 
 /*
- * Tratamiento de llamada al sistema escribir. Llama simplemente a la
- * funcion de apoyo escribir_ker
+ * Tratamiento de llamada al sistema escribir. Escribe en el terminal a
+ * traves de su manejador
  */
 int sis_escribir()
 {
@@ -463,10 +1179,38 @@ int sis_escribir()
 	texto=(char *)leer_registro(1);
 	longi=(unsigned int)leer_registro(2);
 
-	escribir_ker(texto, longi);
+	tabla_dispositivos[DISP_TERMINAL].escribir(texto, longi);
 	return 0;
 }
 
+/*
+ * Tratamiento de llamada al sistema escribirv. Escribe en el terminal,
+ * en orden, los n trozos del vector, y devuelve el total de bytes escritos.
+ * La salida con buffer de la biblioteca indica ademas de que proceso es el
+ * buffer; si no es del actual no escribe nada y devuelve -1, porque es el
+ * de un proceso que murio sin vaciarlo. Con -1 no se comprueba
+ */
+int sis_escribirv()
+{
+	vector_es *vector;
+	unsigned int n, i;
+	int propietario, total=0;
+
+	vector=(vector_es *)leer_registro(1);
+	n=(unsigned int)leer_registro(2);
+	propietario=(int)leer_registro(3);
+	if (vector==NULL || n > MAX_VECTOR_ES){
+		printk_error("ERROR: vector de escribirv no valido. \n");
+		return -1;
+	}
+	if (propietario>=0 && propietario!=p_proc_actual->id)
+		return -1;
+	for (i=0; i<n; i++)
+		total+=tabla_dispositivos[DISP_TERMINAL].escribir(vector[i].texto,
+			vector[i].longi);
+	return total;
+}
+
 
 /*
  * Tratamiento de llamada al sistema terminar_proceso. Llama a la
@@ -474,18 +1218,18 @@ int sis_escribir()
  */
 int sis_terminar_proceso(){
 
-	printk("-> FIN PROCESO %d\n", p_proc_actual->id);
+	printk_info("-> FIN PROCESO %d\n", p_proc_actual->id);
 
 	liberar_proceso();
 
-        return 0; /* no debera llegar aqui */
+        return 0; /* no debería llegar aqui */
 }
 
 //Objetivo parcial 1: Inclusion de una llamada simple
 //codigo de la nueva funcion
 int obtener_id_pr(){
 	
-        printk("-> ID DEL PROCESO ACTUAL %d\n", p_proc_actual->id);
+        printk_traza("-> ID DEL PROCESO ACTUAL %d\n", p_proc_actual->id);
 
         return p_proc_actual->id;
 }
@@ -496,151 +1240,226 @@ int obtener_id_pr(){
  *
  */
 
-/*
-//Funcion que bloquea el proceso que se esta ejecutando actualmente
-static void bloquear(lista_BCPs *lista){
-        BCP * p_proc_anterior; //Declaramos un puntero al proceso anterior
-        int nivel;
-
-        p_proc_actual->estado=BLOQUEADO; //Bloqueamos el proceso actual
-        p_proc_anterior = p_proc_actual;  //y volvemos al proceso anterior
-
-        nivel=fijar_nivel_int(NIVEL_3);   //Fijamos el nivel
-
-        //El proceso no sigue, si hay alguna replanificacion pendiente hay que desactivarla
-        eliminar_primero(&lista_listos);
+//Inserta un proceso en la cubeta de la rueda de dormidos que corresponde
+//a su instante de despertar, manteniendola ordenada por ese instante. Se
+//recorre desde el final porque lo normal es que despierte despues que los
+//que ya estan en la cubeta. Devuelve 1 si ya habia otro proceso que
+//despierta en el mismo tick
+static int insertar_rueda(BCP * proc){
+	lista_BCPs *cubeta=&rueda_dormidos[proc->despertar & (NUM_CUBETAS_RUEDA-1)];
+	BCP *previo=cubeta->ultimo;
+
+	while (previo && previo->despertar > proc->despertar)
+		previo=previo->ant_temp;
+
+	proc->ant_temp=previo;
+	proc->sig_temp=previo ? previo->sig_temp : cubeta->primero;
+	if (previo)
+		previo->sig_temp=proc;
+	else
+		cubeta->primero=proc;
+	if (proc->sig_temp)
+		proc->sig_temp->ant_temp=proc;
+	else
+		cubeta->ultimo=proc;
+	return previo && previo->despertar==proc->despertar;
+}
 
-        insertar_ultimo(lista, p_proc_anterior);  //Insertamos en la ultima posicion de la lista el proceso anterior
-        
-	//Al proceso actual le igualamos al planificador
-        p_proc_actual = planificador;   
+//Quita un proceso de la cubeta de la rueda en la que esta
+static void eliminar_rueda(BCP * proc){
+	lista_BCPs *cubeta=&rueda_dormidos[proc->despertar & (NUM_CUBETAS_RUEDA-1)];
 
-        cambio_contexto(&(p_proc_anterior->contexto_regs),&(p_proc_actual->contexto_regs));
-        
-        fijar_nivel_int(nivel);
+	if (proc->ant_temp)
+		proc->ant_temp->sig_temp=proc->sig_temp;
+	else
+		cubeta->primero=proc->sig_temp;
+	if (proc->sig_temp)
+		proc->sig_temp->ant_temp=proc->ant_temp;
+	else
+		cubeta->ultimo=proc->ant_temp;
+	proc->sig_temp=proc->ant_temp=NULL;
 }
 
-//Funcion para desbloquear un proceso dormido
-static void desbloquear(BCP * proc, lista_BCPs *lista){
-        int nivel;
-        
-	//Ponemos el proceso en estado listo
-        proc->estado=LISTO;
-        nivel=fijar_nivel_int(NIVEL_3);
-	//De la lista espera eliminamos el proceso ya listo
-        eliminar_elem(lista, proc);
-	//Y insertamos en la lista de procesos listos el anterior proceso
-        insertar_ultimo(&lista_listos, proc);
-        fijar_nivel_int(nivel);
+//Elige el tick de despertar dentro de [instante, instante+holgura] con
+//mas ceros en los bits bajos, de modo que los dormidos con plazos
+//parecidos tienden a coincidir en el mismo tick
+static unsigned int aplicar_holgura(unsigned int instante, unsigned int holgura){
+	unsigned int limite, distintos;
+
+	limite=instante+holgura;
+	distintos=instante^limite;
+	if (distintos==0)
+		return instante;
+	//Se conserva el prefijo comun y el primer bit en que difieren
+	return limite & ~((1U << (31-__builtin_clz(distintos)))-1);
 }
-*/
 
-//Funcion auxiliar que decrementa el tiempo de espera y cuando llega a 0 lo desbloquea
+//Funcion auxiliar que contabiliza el tick y despierta a los procesos cuyo
+//instante de despertar ha llegado. Solo se mira la cubeta de este tick, y
+//como esta ordenada basta con tomar su principio
 void ajustar_dormidos() {
-        /*
+        lista_BCPs *cubeta;
         BCP * p_aux;
-        BCP * p_sig;
-
-        p_aux=lista_dormidos.primero;
-        while (p_aux) {
-            p_sig=p_aux->siguiente;
-            if (--p_aux->plazo==0)
-               desbloquear(p_aux, &lista_dormidos);
-            p_aux=p_sig;
-        }
-        */
-        
+        BCP * despertados;
+        BCP * ultimo=NULL;
+
        	//Tiempo de los procesos
 	n_interrup++;
 	//Asignamos las interrupciones al usuario o al sistema
-	if(lista_listos.primero != NULL){
+	if(!esperando_int){
 		if(viene_de_modo_usuario()){
 			p_proc_actual->veces_usuario++;
 		}
 		else{
 			p_proc_actual->veces_sistema++;
 		}
+		if (POLITICA_PLANIF==PLANIF_CFS)
+			actualizar_vruntime(p_proc_actual);
+		else if (POLITICA_PLANIF==PLANIF_STRIDE)
+			actualizar_pase(p_proc_actual);
 	}
 
-	//Tratamos los procesos dormidos 
-	if(lista_dormidos.primero != NULL){
-		BCP * proc_dormido;
-		BCP * dorm_aux;
-
-		proc_dormido = lista_dormidos.primero;
-                //Mientras no haya procesos dormidos
-		while(proc_dormido != NULL){
-			proc_dormido->plazo--;
-			//Si termina la espera de algun proceso
-			if(proc_dormido->plazo <= 0){
-				//Se vuelve a ajustar la lista dormidos
-				proc_dormido->estado = LISTO;
-
-				if(proc_dormido->siguiente != NULL){
-					//El auxiliar apunta al siguiente de los procesos dormidos
-					dorm_aux = proc_dormido->siguiente;
-					//Elimina los dormidos de la lista dormidos y los inserta en lo ultimo de la lista listos
-					eliminar_elem(&lista_dormidos, proc_dormido);
-					insertar_ultimo(&lista_listos, proc_dormido);
-					proc_dormido = dorm_aux;
-				}
-				else{
-					eliminar_elem(&lista_dormidos, proc_dormido);
-					insertar_ultimo(&lista_listos, proc_dormido);
-				}
-				proc_dormido = proc_dormido->siguiente;
-			}
-		}
-	}     
+	//Los que vencen forman el principio de la cubeta; se separa entero
+        cubeta=&rueda_dormidos[n_interrup & (NUM_CUBETAS_RUEDA-1)];
+        despertados=cubeta->primero;
+        for (p_aux=despertados; p_aux && p_aux->despertar <= (unsigned int)n_interrup; p_aux=p_aux->sig_temp)
+                ultimo=p_aux;
+        if (ultimo==NULL)
+                return;
+        cubeta->primero=ultimo->sig_temp;
+        if (cubeta->primero)
+                cubeta->primero->ant_temp=NULL;
+        else
+                cubeta->ultimo=NULL;
+        ultimo->sig_temp=NULL;
+
+	//Y se pasan a listos en orden; basta con que uno expulse al actual.
+	//A los que esperaban con plazo se les saca de su lista de espera
+        while ((p_aux=despertados)) {
+                despertados=p_aux->sig_temp;
+                p_aux->sig_temp=p_aux->ant_temp=NULL;
+                if (p_aux->espera_con_plazo){
+                        eliminar_elem(p_aux->espera_con_plazo, p_aux);
+                        p_aux->espera_con_plazo=NULL;
+                        p_aux->plazo_vencido=1;
+                }
+                poner_listo(p_aux);
+                if (!replanificacion_pendiente)
+                        comprobar_expropiacion(p_aux);
+        }
+}
+
+//Bloquea al proceso actual hasta el tick absoluto indicado, retrasado
+//dentro de su holgura si no es EDF. Si ese instante ya ha llegado no se
+//bloquea
+static void bloquear_hasta(unsigned int instante){
+        int nivel;
+
+        //Bloqueamos el proceso hasta el instante absoluto de despertar
+        nivel=fijar_nivel_int(NIVEL_3);
+        if ((int)(instante - (unsigned int)n_interrup) <= 0){
+                fijar_nivel_int(nivel);
+                return;
+        }
+ 	p_proc_actual->estado = BLOQUEADO;
+ 	p_proc_actual->despertar = instante;
+ 	if (!p_proc_actual->edf)
+ 		p_proc_actual->despertar = aplicar_holgura(instante, p_proc_actual->holgura);
+
+ 	printk_depuracion("-> EL PROCESO ACTUAL %d DUERME %u\n", p_proc_actual->id, instante-n_interrup);
+ 	subir_nivel_mlfq();
+
+        //Lo metemos en la rueda de dormidos y cedemos el procesador. Si la
+        //holgura le ha llevado a un tick en el que ya despierta otro, ese
+        //despertar se ahorra
+        if (insertar_rueda(p_proc_actual) && p_proc_actual->despertar!=instante)
+                despertares_ahorrados++;
+ 	cambio_proc(NULL);
+        fijar_nivel_int(nivel);
+}
+
+//Bloquea al proceso actual, que ya esta en la lista de espera dada, como
+//mucho durante el plazo en ticks indicado. Si vence antes de que le
+//despierten, int_reloj le saca de la lista y devuelve -1. Si le despiertan
+//antes, poner_listo le quita de la rueda. Se llama con las interrupciones
+//inhibidas al menos a nivel 1, pero como int_reloj modifica la lista, toda
+//insercion o extraccion en ella se hace a nivel 3
+static int esperar_con_plazo(lista_BCPs *lista, unsigned int ticks){
+        int nivel;
+
+        nivel=fijar_nivel_int(NIVEL_3);
+        p_proc_actual->estado=BLOQUEADO;
+        p_proc_actual->despertar=n_interrup + ticks;
+        p_proc_actual->espera_con_plazo=lista;
+        p_proc_actual->plazo_vencido=0;
+        insertar_rueda(p_proc_actual);
+        cambio_proc(NULL);
+        fijar_nivel_int(nivel);
+
+        return p_proc_actual->plazo_vencido ? -1 : 0;
 }
 
 //Objetivo parcial 2: bloquea al proceso un plazo de tiempo
 int dormir(){	
         unsigned int segundos;
         segundos = (unsigned int)leer_registro(1);
-       
-        /*
-        //Al proceso actual le pongo los segundos en ticks que quiero que este dormido
-        p_proc_actual->plazo=segundos*TICK;
-        
-        //Bloque el proceso 
-        //bloquear(&lista_dormidos);
-	
-	//se bloquea el proceso
-	p_proc_actual->estado=BLOQUEADO;
-	cambio_proceso(&lista_dormidos);
-	
-	printk("-> EL PROCESO ACTUAL HA DORMIDO %d\n", (segundos*TICK));
-	
-	*/
 
-  	BCP * p_proc_anterior;
- 	//Bloqueamos el proceso e insertamos el tiempo de bloqueo
- 	p_proc_actual->estado = BLOQUEADO;
- 	p_proc_actual->plazo = segundos*TICK;
-	
- 	p_proc_actual->replanificacion = 0;
- 	nivel_anterior = fijar_nivel_int(NIVEL_3);
-	
-        //Lo quitamos de la lista de procesos listos y lo metemos en la de dormidos
- 	eliminar_primero(&lista_listos);
- 	insertar_ultimo(&lista_dormidos, p_proc_actual);
- 	//Realizar cambio de contexto
- 	p_proc_anterior = p_proc_actual;
- 	p_proc_actual = planificador();
-
- 	printk("Duerme desde el proceso %d hasta %d\n", p_proc_anterior->id, p_proc_actual->id);
-
- 	//Restauramos el contexto de nuestro nuevo proc_actual
- 	cambio_contexto(&(p_proc_anterior->contexto_regs), &(p_proc_actual->contexto_regs));
- 	//Recuperamos el nivel anterior de interrupciones
- 	fijar_nivel_int(nivel_anterior);
-	
-	printk("-> EL PROCESO ACTUAL %d HA DORMIDO %u\n", p_proc_actual->id, p_proc_actual->plazo);
+	//Un plazo nulo no bloquea
+	if (segundos==0)
+		return 0;
 
+        bloquear_hasta(n_interrup + segundos*TICK);
         return 0; //Llamada no da error
 }
 
+//Bloquea al proceso un plazo en ticks de reloj
+int sis_dormir_ticks(){
+        unsigned int ticks;
+        ticks = (unsigned int)leer_registro(1);
+
+	if (ticks==0)
+		return 0;
+
+        bloquear_hasta(n_interrup + ticks);
+        return 0;
+}
+
+//Bloquea al proceso hasta el tick absoluto indicado, para que las tareas
+//periodicas no acumulen deriva. Si ya ha pasado vuelve enseguida
+int sis_dormir_hasta(){
+        unsigned int instante;
+        instante = (unsigned int)leer_registro(1);
+
+        bloquear_hasta(instante);
+        return 0;
+}
+
+//Devuelve el numero de ticks de reloj desde el arranque
+int sis_obtener_ticks(){
+        return n_interrup;
+}
+
+//Fija la holgura de temporizacion del proceso actual en ticks y devuelve
+//la anterior
+int sis_fijar_holgura(){
+        int holgura, anterior;
+        holgura = (int)leer_registro(1);
+
+        if (holgura < 0 || holgura > MAX_HOLGURA){
+                printk_error("ERROR: holgura no valida. \n");
+                return -1;
+        }
+        anterior=p_proc_actual->holgura;
+        p_proc_actual->holgura=holgura;
+        return anterior;
+}
+
+//Devuelve cuantos despertares se han ahorrado desde el arranque al
+//agrupar procesos dormidos en un mismo tick
+int sis_despertares_ahorrados(){
+        return despertares_ahorrados;
+}
+
  /*
   * 
   * Tratamiento de la llamada al sistema tiempos_proceso
@@ -661,195 +1480,235 @@ int dormir(){
 } 
 
 /*
-*
-* Nos hemos creado varias funciones auxiliares que realizan las operaciones del objetivo parcial 3 del mutex
-*
-*/
-
-//Funcion auxiliar que nos dice si el proceso actual tiene algun descriptor o no.
-//Devuelve el descriptor si existe y en caso contrario un -1
-int tiene_descriptor(){
-	int tiene = 0;
-	int n = 0;
-	//Mientras el numero auxiliar sea menor al maximo numero de mutex que pueda tener un proceso y no tenga descriptor seguira ejecutandose el bucle
-	while((n < NUM_MUT_PROC) && (!tiene)){
-		//Comprueba que haya un decriptor 
-		if(p_proc_actual->descriptores[n].libre == 0){
-			tiene = 1;
-			//printk("El proceso actual tiene un descriptor.\n");
-		}
-		//Aumentamos el contador de numeros
-		n++;
-	}
-	
-	//En caso de haber descriptor devuelve pues el numero de donde esta el descriptor
-	if(tiene){
-	        printk("El proceso actual %d tiene un descriptor.\n", (n-1));
-		return n-1;
-	}else{
-	 //En caso de que no haya decriptor devuelve un numero negativo -1
-	        printk("No tiene descriptor. \n");
-		return -1;
+ *
+ * Espacio de nombres del nucleo, compartido por todos los objetos con nombre
+ *
+ */
+
+//Inicia la tabla de nombres con todas las entradas libres
+static void iniciar_nombres(){
+	int i;
+
+	for (i=0; i<NUM_CUBETAS_NOMBRES; i++)
+		cubetas_nombres[i]=-1;
+	for (i=0; i<MAX_NOMBRES; i++){
+		tabla_nombres[i].clase=NOMBRE_LIBRE;
+		tabla_nombres[i].siguiente=i+1;
 	}
+	tabla_nombres[MAX_NOMBRES-1].siguiente=-1;
+	nombres_libres=0;
 }
 
-//Funcion auxiliar que nos dice si hay algun descriptor libre en el proceso actual
-//Devuelve que esta lleno si no hay libre y un n-1 en caso contrario
-int libre(){
-	int tiene_libre = 0;
-	int n = 0;
-        //Mientras el numero sea menor al maximo numero de mutex que pueda tener un proceso y no tenga descriptor seguira ejecutandose el bucle
-	while((n < NUM_MUT) && (!tiene_libre)){
-		//Comprobamos si en el array de mutex segun la posicion los numeros de procesos son menores o iguales a 0 entonces es que tiene ya un descriptor
-		if(array_mutex[n].procesos_mutex <= 0){
-			tiene_libre = 1;
-			printk("Hay un descriptor libre en proceso de mutex %d actual.\n",array_mutex[n].procesos_mutex);
-		}
-		//Aumentamos el contador de numeros
-		n++;
-	}
-	
-	if(!tiene_libre){
-	        printk("Esta lleno y no queda descriptor libre.\n");
-		return LLENO;
-	}else{
-	        printk("Descriptor libre en %d .\n", (n-1));
-	        return n-1;
+//Devuelve la longitud del nombre o -1 si supera MAX_NOM_MUT, sin leer mas
+//alla de ese limite
+static int longitud_nombre(const char *nombre){
+	int n;
+
+	for (n=0; n<=MAX_NOM_MUT; n++)
+		if (nombre[n]=='\0')
+			return n;
+	return -1;
+}
+
+//Funcion de dispersion (FNV-1a) sobre la clase y el nombre
+static unsigned int cubeta_nombre(const char *nombre, int clase){
+	unsigned int h=2166136261U ^ (unsigned int)clase;
+
+	for (; *nombre; nombre++)
+		h=(h ^ (unsigned char)*nombre) * 16777619U;
+	return h & (NUM_CUBETAS_NOMBRES-1);
+}
+
+//Busca un nombre de la clase dada y devuelve el indice de su objeto, o -1
+//si no esta registrado. El nombre debe tener una longitud valida
+static int buscar_nombre(const char *nombre, int clase){
+	int e;
+
+	busquedas_nombres++;
+	for (e=cubetas_nombres[cubeta_nombre(nombre, clase)]; e!=-1; e=tabla_nombres[e].siguiente){
+		comparaciones_nombres++;
+		if (tabla_nombres[e].clase==clase && strcmp(tabla_nombres[e].nombre, nombre)==0)
+			return tabla_nombres[e].indice;
 	}
+	return -1;
 }
 
-//Funcion auxiliar que comprueba si existe o no un mutex dado
-//Devuelve 1 en caso de encontrarlo y 0 en caso contrario
-int existe_mutex(char*nom){
-	int existe = 0;
-	int n = 0;
+//Registra un nombre para el objeto indice de la clase dada. Devuelve -1 si
+//ya existe o si no quedan entradas libres
+static int registrar_nombre(const char *nombre, int clase, int indice){
+	int e, c;
 
-	//Mientras el numero sea menor al maximo numero de mutex que pueda tener un proceso y no tenga descriptor seguira ejecutandose el bucle
-	while((n < NUM_MUT) && (!existe)){
-		//Buscamos en indices que tengan mutex
-		if(array_mutex[n].procesos_mutex > 0) {
-			//Verificamos si el nombre coincide
-			if(strcmp(nom, array_mutex[n].nombre)){
-				existe = 1;
-				printk("El nombre introducido coincide con el del mutex.\n");
-			}
+	if (buscar_nombre(nombre, clase)>=0 || nombres_libres==-1)
+		return -1;
+	e=nombres_libres;
+	nombres_libres=tabla_nombres[e].siguiente;
+
+	strcpy(tabla_nombres[e].nombre, nombre);
+	tabla_nombres[e].clase=clase;
+	tabla_nombres[e].indice=indice;
+	c=cubeta_nombre(nombre, clase);
+	tabla_nombres[e].siguiente=cubetas_nombres[c];
+	cubetas_nombres[c]=e;
+	return 0;
+}
+
+//Borra el nombre de la clase dada y deja su entrada libre
+static void borrar_nombre(const char *nombre, int clase){
+	int *enlace;
+	int e;
+
+	for (enlace=&cubetas_nombres[cubeta_nombre(nombre, clase)]; (e=*enlace)!=-1; enlace=&tabla_nombres[e].siguiente){
+		if (tabla_nombres[e].clase==clase && strcmp(tabla_nombres[e].nombre, nombre)==0){
+			*enlace=tabla_nombres[e].siguiente;
+			tabla_nombres[e].clase=NOMBRE_LIBRE;
+			tabla_nombres[e].siguiente=nombres_libres;
+			nombres_libres=e;
+			return;
 		}
-		//Aumentamos el contador de numeros
-		n++;
-	}
-	
-	if(existe){
-	        printk("El mutex buscado por el nombre existe.\n");
-		return 1;
-	}else{
-	        printk("El mutex buscado por el nombre no existe.\n");
-		return 0;
 	}
 }
 
-//Funcion auxiliar que comprueba la posicion de un mutex dado previamente un nombre
-//Devuelve la posicion en caso de encontrarlo y -1 en caso contrario
-int pos_mutex(char*nombre){
-	int existe = 0;
-	int n = 0;
+//Rellena las busquedas hechas en el espacio de nombres y las entradas
+//comparadas en ellas, y devuelve el numero de nombres registrados
+int sis_coste_nombres(){
+	struct coste_nombres *coste;
+	int e, n=0;
 
-	//Mientras el numero sea menor al maximo numero de mutex que pueda tener un proceso y no tenga descriptor seguira ejecutandose el bucle
-	while((n < NUM_MUT) && (!existe)){
-		//seleccionamos solo aquellos indices con un mutex
-		if (array_mutex[n].procesos_mutex > 0){
-			//Comprobamos si coincide el nombre del mutex con el nombre escrito en la funcion
-			if(strcmp(nombre, array_mutex[n].nombre) == 0){
-				existe = 1;
-			}
-		}
-		//Aumentamos el contador de numeros
-		n++;
+	coste=(struct coste_nombres *)leer_registro(1);
+	if (coste!=NULL){
+		coste->busquedas=busquedas_nombres;
+		coste->comparaciones=comparaciones_nombres;
 	}
-	
-	if(!existe){
-	        printk("No hay posicion porque no existe.\n");
+	for (e=0; e<MAX_NOMBRES; e++)
+		if (tabla_nombres[e].clase!=NOMBRE_LIBRE)
+			n++;
+	return n;
+}
+
+/*
+ *
+ * Tabla de descriptores de cada proceso
+ *
+ */
+
+//Reserva la primera entrada libre de la tabla de descriptores del proceso
+//actual para el objeto dado y devuelve su descriptor, o -1 si esta llena
+static int asignar_descriptor(int tipo, int objeto){
+	tipo_descriptor *d;
+	int i;
+
+	if (p_proc_actual->descriptores_libres==0)
 		return -1;
-	}else{
-	        printk("La posicion del mutex es %d .\n",(n-1));
-		return n-1;
-	}
+	i=__builtin_ffs(p_proc_actual->descriptores_libres)-1;
+	p_proc_actual->descriptores_libres &= ~(1U << i);
+
+	d=&p_proc_actual->descriptores[i];
+	d->tipo=tipo;
+	d->objeto=objeto;
+	return (d->generacion << BITS_DESCRIPTOR) | i;
 }
 
+//Devuelve la entrada del proceso actual a la que se refiere el descriptor
+//si es del tipo pedido y sigue abierto, o NULL en otro caso
+static tipo_descriptor * resolver_descriptor(int desc, int tipo){
+	tipo_descriptor *d;
+
+	if (desc < 0)
+		return NULL;
+	d=&p_proc_actual->descriptores[desc & (MAX_DESCRIPTORES-1)];
+	if (d->tipo!=tipo || d->generacion!=(desc >> BITS_DESCRIPTOR))
+		return NULL;
+	return d;
+}
+
+//Libera una entrada de la tabla de descriptores del proceso actual y
+//avanza su generacion para invalidar el descriptor que la nombraba
+static void liberar_descriptor(tipo_descriptor *d){
+	int i=d-p_proc_actual->descriptores;
+
+	d->tipo=DESC_LIBRE;
+	d->generacion=(d->generacion+1) & (MAX_GENERACION-1);
+	p_proc_actual->descriptores_libres |= (1U << i);
+}
 
- 
 /*
  * 
  * Todo el objetivo 3 de ofrecer sincronizacion basado en mutex
  *
  */
-//Crear un mutex
-int sis_crear_mutex(){
-        //Declaramos las variables de nombres y tipos especificados
-        char *nombre;
-	int tipo;
-        
-	//Para cada uno de ellos le asginamos en un hueco del registro
-	nombre=(char *)leer_registro(1);
-	tipo=(int)leer_registro(2);
-	
-	BCP * p_proc_anterior;
- 	int pos;
- 	int existe; 
+//Crear un mutex. Si no queda ninguno libre en el sistema espera a que se
+//libere uno, salvo que no sea bloqueante
+static int crear_mutex(char *nombre, int tipo, int bloqueante){
+	int disponibilidad;
+
+ 	//El nombre se guarda en el mutex, asi que no puede superar el maximo
+ 	if(nombre == NULL || longitud_nombre(nombre) < 0){
+ 		printk_error("ERROR, nombre de mutex demasiado largo. \n");
+ 		return -1;
+ 	}
 
- 	//Comprueba si en posicion hay descriptor
- 	pos = tiene_descriptor();
- 	//En caso de no encontrarlo devuelve un -1
- 	if(pos == -1){
- 		printk("ERROR, no tiene descriptor. \n");
+ 	//Comprueba si le queda algun descriptor libre
+ 	if(p_proc_actual->descriptores_libres == 0){
+ 		printk_error("ERROR, no tiene descriptor. \n");
  		return -1;
  	}
 
- 	//Si encuentra un descriptor es que existe un mutex y devuelve un error
- 	existe = existe_mutex(nombre);
- 	if(existe) {
- 		printk("ERROR, ya existe un mutex con este nombre. \n");
+ 	//Si el nombre ya esta registrado es que existe un mutex y devuelve un error
+ 	if(buscar_nombre(nombre, NOMBRE_MUTEX) >= 0) {
+ 		printk_error("ERROR, ya existe un mutex con este nombre. \n");
  		return -1;
  	}
 
- 	//Comprueba si hay disponibilidad
- 	int disponibilidad = libre();
+	if(!bloqueante && mutex_libres == 0){
+		printk_error("ERROR, no quedan mutex libres. \n");
+		return -1;
+	}
 
- 	//Mientras disponibilidad este llena se ejecuta el bucle
- 	while(disponibilidad == LLENO){
+ 	//Mientras no quede ningun mutex libre en el sistema se bloquea
+ 	while(mutex_libres == 0){
  		p_proc_actual->estado = BLOQUEADO;
- 		p_proc_actual->replanificacion = 0;
- 		nivel_anterior = fijar_nivel_int(NIVEL_3);
- 		eliminar_primero(&lista_listos);
- 		//Insertamos al final de la lista mutex el proceso actual
- 		insertar_ultimo(&lista_de_mutex, p_proc_actual);
- 		//Cambio de contexto del proceso anterior al actual
- 		p_proc_anterior = p_proc_actual;
- 		//Esperamos a que haya un proceso listo
- 		p_proc_actual = planificador();
  		//Imprimimos por pantalla un mensaje
- 		printk("Crea mutex del proceso %d a %d\n", p_proc_anterior->id, p_proc_actual->id);
- 		//Restauramos contexto del nuevo proceso actual
- 		cambio_contexto(&(p_proc_anterior->contexto_regs), &(p_proc_actual->contexto_regs));
- 		fijar_nivel_int(nivel_anterior);
- 		disponibilidad = libre();
+ 		printk_depuracion("Crea mutex del proceso %d bloqueado\n", p_proc_actual->id);
+ 		//Insertamos al final de la lista mutex el proceso actual y cedemos el procesador
+ 		cambio_proc(&lista_de_mutex);
+ 	}
+ 	disponibilidad = __builtin_ffs(mutex_libres) - 1;
+
+ 	//Mientras esperaba otro proceso ha podido crear uno con el mismo nombre
+ 	if(registrar_nombre(nombre, NOMBRE_MUTEX, disponibilidad) < 0){
+ 		printk_error("ERROR, ya existe un mutex con este nombre. \n");
+ 		return -1;
  	}
 
  	//Despues de comprobar todo creamos el mutex segun la estructuta de la cabecera
- 	array_mutex[disponibilidad].procesos_mutex++;
- 	array_mutex[disponibilidad].nombre = strdup(nombre);
+ 	mutex_libres &= ~(1U << disponibilidad);
+ 	array_mutex[disponibilidad].procesos_mutex = 1;
+ 	strcpy(array_mutex[disponibilidad].nombre, nombre);
 	array_mutex[disponibilidad].tipo = tipo;
- 	array_mutex[disponibilidad].propietario = p_proc_actual->id;
- 	
- 	
-
- 	p_proc_actual->descriptores[pos].descript = disponibilidad;
- 	p_proc_actual->descriptores[pos].libre = 1;
+ 	array_mutex[disponibilidad].propietario = -1;
+ 	array_mutex[disponibilidad].bloqueado = 0;
+	array_mutex[disponibilidad].esperan_multiple = 0;
 	
-	printk("Mutex tipo %d creado \n", tipo);
+	printk_depuracion("Mutex tipo %d creado \n", tipo);
 	
- 	return disponibilidad;
+ 	return asignar_descriptor(DESC_MUTEX, disponibilidad);
 	             
 }
+int sis_crear_mutex(){
+        //Declaramos las variables de nombres y tipos especificados
+        char *nombre;
+	int tipo;
+        
+	//Para cada uno de ellos le asginamos en un hueco del registro
+	nombre=(char *)leer_registro(1);
+	tipo=(int)leer_registro(2);
+
+	return crear_mutex(nombre, tipo, 1);
+}
+//Crear un mutex sin esperar si no queda ninguno libre
+int sis_intentar_crear_mutex(){
+	return crear_mutex((char *)leer_registro(1), (int)leer_registro(2), 0);
+}
 //Abre un mutex
 int sis_abrir_mutex(){
         //Declaramos la variable nombre 
@@ -858,341 +1717,1581 @@ int sis_abrir_mutex(){
 	//Guardamos el nombre en el registro 1
 	nombre=(char *)leer_registro(1);
 	
-	/*
-	
-	//Abrimos el muetx
-        //Espacio para crear mutex
-	int pMutex = -1;
-	for(int i=0; i<NUM_MUT; i++){
-	    array_mutex[i].procesos[p_proc_actual->id] = 1;
-	    pMutex = i;
-	}
-	
-	//Busca el mutex por su descriptor
-	int descrip = -1;
-	//Bucle donde recorre numero maximo de mutex que puede tener abiertos un proceso
-	for(int i=0; i<NUM_MUT_PROC; i++){
-	  if(p_proc_actual->array_mutex_proceso[i] == NULL){
-	       p_proc_actual->array_mutex_proceso[i] = &array_mutex[pMutex];
-	       p_proc_actual->numeroMutex++;
-	       descrip = i;
-	  }
-	}
-	
-	*/
-	
  	int pos;
- 	int existe;
- 	int descriptor;
 
- 	pos = tiene_descriptor();
- 	//Si no hay descriptor:
- 	if(pos == -1){
- 		printk("ERROR, no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+ 	//Si no le quedan descriptores:
+ 	if(p_proc_actual->descriptores_libres == 0){
+ 		printk_error("ERROR, no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
 		
  		return -1;
  	}
 
  	//Si hay descriptor pero no exite nombre, otro mensaje de error
- 	existe = existe_mutex(nombre);
- 	if(!existe){
- 		printk("Error debido a que no existe el mutex con ese nombre\n");
+ 	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+ 	   (pos = buscar_nombre(nombre, NOMBRE_MUTEX)) < 0){
+ 		printk_error("Error debido a que no existe el mutex con ese nombre\n");
 		
  		return -1;
  	}
 
  	//Si hemos llegado hasta aqui se han cumplido las precondiciones por lo que concedemos el descriptor al mutex
- 	descriptor = pos_mutex(nombre);
- 	array_mutex[descriptor].procesos_mutex++;
- 	p_proc_actual->descriptores[pos].descript = descriptor;
- 	p_proc_actual->descriptores[pos].libre = 1;
+ 	array_mutex[pos].procesos_mutex++;
 
-        printk("El mutex %d abierto.\n",descriptor);	
+        printk_depuracion("El mutex %d abierto.\n", pos);	
 	
- 	return descriptor;
+ 	return asignar_descriptor(DESC_MUTEX, pos);
       
 }
-//Intenta bloquear el mutex, no recursivo
-int sis_lock(){
-        unsigned int mutexid;
-	mutexid=(unsigned int)leer_registro(1);
-	
-	BCP*p_proc_anterior;
-	int bloqueado;
+//Indica si se le puede dar ya al proceso todo el conjunto que espera con
+//lock_multiple: cada mutex esta libre o es un recursivo suyo
+static int conjunto_disponible(BCP * proc){
+	mutex *mut;
+	int i;
 
-	mutex mut = array_mutex[mutexid];
-	
-	do{
-		bloqueado = 0;
-		if(mut.procesos_mutex > 0){
-			//Verificamos si esta o no bloqueado
-			if(mut.bloqueado > 0){
-				//Comprobamos si es RECURSIVO
-				if(mut.tipo == RECURSIVO){
-					//Comprobamos si es el propietario del mutex
-					if(mut.propietario == p_proc_actual->id){
-						//Aumentamos el numero de bloqueos en el mutex
-						mut.bloqueado++;
-					}else{
-				        //En caso contrario bloquea al proceso
-						p_proc_actual->estado = BLOQUEADO;
-						//No hace ya cambios de contexto involuntario
-						p_proc_actual->replanificacion = 0;
-						nivel_anterior = fijar_nivel_int(NIVEL_3);
-
-						eliminar_primero(&lista_listos);
-						//Lo insertamos en la lista de bloqueados por un lock
-						insertar_ultimo(&lista_de_bloqueados, p_proc_actual);
-						//Hacemos un cambio de Contexto
-						p_proc_anterior = p_proc_actual;
-						p_proc_actual = planificador();
-
-						printk("Del proceso anterior %d a actual %d por un Lock. \n", p_proc_anterior->id, p_proc_actual->id);
-						
-						//Restauramos el contexto del nuevo actual
-						cambio_contexto(&(p_proc_anterior->contexto_regs), &(p_proc_actual->contexto_regs));
-						fijar_nivel_int(nivel_anterior);
-						//Y bloqueamos para que no se escape ningun proceso
-						bloqueado = 1;
-					}
-				}else if(mut.tipo == NO_RECURSIVO){
-					//Vemos si es el propietario del mutex
-					if(mut.propietario == p_proc_actual->id){
-						//Comprobamos si ya hay un proceso bloqueandolo
-						//Imprimimos por pantalla error por interbloqueo
-						printk("Error debido a un interbloqueo.\n");
-							
-						//En caso contrario bloqueamos el mutex
-						mut.bloqueado++;
-						
-						return -1;
-					}else{
-				        //Bloqueamos si no es propietario
-						p_proc_actual->estado = BLOQUEADO;
-						//Ya no es necesario hacer cambio de contexto involuntario
-						p_proc_actual->replanificacion = 0;
-						nivel_anterior = fijar_nivel_int(NIVEL_3);
-						
-						eliminar_primero(&lista_listos);
-						insertar_ultimo(&lista_de_bloqueados, p_proc_actual);
-						//Cambio de contexto
-						p_proc_anterior = p_proc_actual;
-						p_proc_actual = planificador();
-
-						printk("Del proceso anterior %d a actual %d por un Lock. \n", p_proc_anterior->id, p_proc_actual->id);
-						
-						//Restauramos el contexto del nuevo actual
-						cambio_contexto(&(p_proc_anterior->contexto_regs),&(p_proc_actual->contexto_regs));
-						fijar_nivel_int(nivel_anterior);
-
-						//Y bloqueamos para que no se escape ningun proceso
-						bloqueado = 1;
-					}
-				}
-			}else if(mut.bloqueado == 0){
-				//Hacemos que el proceso actual pase a ser el nuevo propietario y bloqueamos al mutex
-			        mut.propietario = p_proc_actual->id;	
-			        mut.bloqueado++;
-			}else{
-				printk("Error del propio mutex. \n");
-				
-				return -1;
-			}
-		}else{
-			printk("ERROR: por hacer lock a un mutex no iniciado \n");
-			
+	for (i=0; i<proc->n_multiple; i++){
+		mut=&array_mutex[proc->conjunto_multiple[i]];
+		if (mut->bloqueado && mut->propietario!=proc->id)
+			return 0;
+	}
+	return 1;
+}
+
+//Da al proceso todo su conjunto de mutex, que debe estar disponible, y
+//deja de contar como que lo espera
+static void tomar_conjunto(BCP * proc){
+	mutex *mut;
+	int i;
+
+	for (i=0; i<proc->n_multiple; i++){
+		mut=&array_mutex[proc->conjunto_multiple[i]];
+		mut->esperan_multiple &= ~(1U << proc->id);
+		mut->propietario=proc->id;
+		mut->bloqueado++;
+	}
+	proc->n_multiple=0;
+}
+
+//De los que esperan con lock_multiple un conjunto que incluye el mutex,
+//el que llego antes de entre los que pueden tomarlo ya entero
+static BCP * elegir_multiple(mutex *mut){
+	unsigned int esperan=mut->esperan_multiple;
+	BCP *proc, *elegido=NULL;
+
+	while (esperan){
+		proc=&tabla_procs[__builtin_ctz(esperan)];
+		esperan &= esperan-1;
+		if (conjunto_disponible(proc) &&
+		    (elegido==NULL || (int)(proc->turno_espera - elegido->turno_espera) < 0))
+			elegido=proc;
+	}
+	return elegido;
+}
+
+//Deja libre el mutex o, si hay procesos esperando, se lo pasa directamente
+//al que llego antes, que vuelve de lock ya como propietario sin tener que
+//competir otra vez por el. Compiten por orden de llegada los de su cola y
+//los que lo esperan con lock_multiple, a los que se da su conjunto entero,
+//pero solo si pueden tomarlo ya: reservarles el mutex mientras esperan los
+//demas podria interbloquearles con quien tiene otro del conjunto y espera
+//este. El anterior propietario deja de heredar la prioridad de los que
+//esperan el mutex y el nuevo pasa a heredarla
+static void ceder_mutex(mutex *mut){
+	BCP *anterior=&tabla_procs[mut->propietario];
+	BCP *siguiente, *multiple;
+	int nivel;
+
+	mut->bloqueado=0;
+	mut->propietario=-1;
+
+	//El que espera con plazo puede vencer en este mismo tick; con el reloj
+	//inhibido se elige y se saca de la cola y de la rueda a la vez, de modo
+	//que o vence antes o ya no vence
+	nivel=fijar_nivel_int(NIVEL_3);
+	siguiente=mut->lista_espera.primero;
+	multiple=elegir_multiple(mut);
+	if (multiple && siguiente && (int)(siguiente->turno_espera - multiple->turno_espera) < 0)
+		multiple=NULL;
+	if (multiple)
+		siguiente=NULL;
+	else if (siguiente){
+		eliminar_elem(&mut->lista_espera, siguiente);
+		if (siguiente->espera_con_plazo){
+			eliminar_rueda(siguiente);
+			siguiente->espera_con_plazo=NULL;
+		}
+	}
+	fijar_nivel_int(nivel);
+
+	if (multiple){
+		tomar_conjunto(multiple);
+		recalcular_prioridad(anterior);
+		recalcular_prioridad(multiple);
+		desbloquear(multiple, &lista_lock_multiple);
+	}
+	else if (siguiente==NULL)
+		recalcular_prioridad(anterior);
+	else {
+		mut->propietario=siguiente->id;
+		mut->bloqueado=1;
+		siguiente->mutex_esperado=NULL;
+		recalcular_prioridad(anterior);
+		recalcular_prioridad(siguiente);
+		desbloquear(siguiente, NULL);
+	}
+	//Si estaba en prorroga por este mutex la deja
+	if (anterior==p_proc_actual)
+		ceder_prorroga();
+}
+
+//Intenta bloquear el mutex; si lo tiene otro proceso espera en la cola
+//del mutex hasta que se lo cedan, o como mucho plazo ticks si no es
+//ESPERA_INDEFINIDA. Con plazo 0 no espera
+static int tomar_mutex(int mutexid, int plazo){
+	tipo_descriptor *d;
+	mutex *mut;
+	int nivel, nivel_reloj, res=0;
+
+	if((d = resolver_descriptor(mutexid, DESC_MUTEX)) == NULL){
+		printk_error("ERROR: por hacer lock a un mutex no iniciado \n");
+		return -1;
+	}
+	//Se trabaja sobre el mutex de la tabla, no sobre una copia
+	mut = &array_mutex[d->objeto];
+
+	//Sin expulsiones mientras se consulta y modifica el mutex
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(mut->bloqueado == 0){
+		//Hacemos que el proceso actual pase a ser el nuevo propietario y bloqueamos al mutex
+		mut->propietario = p_proc_actual->id;
+		mut->bloqueado = 1;
+	}else if(mut->propietario == p_proc_actual->id){
+		//Solo el recursivo admite otro lock de su propietario
+		if(mut->tipo == NO_RECURSIVO){
+			fijar_nivel_int(nivel);
+			printk_error("Error debido a un interbloqueo.\n");
 			return -1;
 		}
-	}while(bloqueado);
+		mut->bloqueado++;
+	}else if(plazo == 0){
+		res = -1;
+	}else{
+		//Espera en la cola del mutex; quien lo libere se lo cede, por lo
+		//que al despertar ya es el propietario. Mientras, el propietario
+		//hereda su prioridad si es mayor
+		p_proc_actual->estado = BLOQUEADO;
+		p_proc_actual->mutex_esperado = mut;
+		printk_depuracion("Proceso %d bloqueado por un Lock. \n", p_proc_actual->id);
+		p_proc_actual->turno_espera = turno_mutex++;
+		nivel_reloj = fijar_nivel_int(NIVEL_3);
+		insertar_ultimo(&mut->lista_espera, p_proc_actual);
+		fijar_nivel_int(nivel_reloj);
+		recalcular_prioridad(&tabla_procs[mut->propietario]);
+		if(plazo == ESPERA_INDEFINIDA)
+			cambio_proc(NULL);
+		else if(esperar_con_plazo(&mut->lista_espera, plazo) < 0){
+			//Vencido el plazo ya no esta en la cola y el propietario,
+			//si aun lo hay, deja de heredar su prioridad
+			p_proc_actual->mutex_esperado = NULL;
+			if(mut->bloqueado)
+				recalcular_prioridad(&tabla_procs[mut->propietario]);
+			res = -1;
+		}
+	}
+	fijar_nivel_int(nivel);
 	
-	return 0;
+	return res;
+}
+int sis_lock(){
+	return tomar_mutex((int)leer_registro(1), ESPERA_INDEFINIDA);
+}
+//Toma el mutex solo si puede hacerlo sin esperar
+int sis_trylock(){
+	return tomar_mutex((int)leer_registro(1), 0);
+}
+//Toma el mutex esperando como mucho el plazo en ticks indicado
+int sis_lock_timeout(){
+	unsigned int ticks=(unsigned int)leer_registro(2);
+
+	if(ticks > MAX_PLAZO){
+		printk_error("ERROR: plazo de lock_timeout no valido. \n");
+		return -1;
+	}
+	return tomar_mutex((int)leer_registro(1), ticks);
 }
 //Desbloquear el mutex, recursivo
 int sis_unlock(){
-        unsigned int mutexid;
-	mutexid=(unsigned int)leer_registro(1);
+        int mutexid;
+	mutexid=(int)leer_registro(1);
 	
-	//Desbloquear el mutex
-	BCP*pr_bloqueado;
-	
-	mutex mut = array_mutex[mutexid];
-
-	//verificamos que existe el mutex
-	if(mut.procesos_mutex > 0){
-		//Comprobamos si esta bloqueado
-		if(mut.bloqueado > 0){
-			//Comprobamos si es recursivo o no
-			if(mut.tipo == RECURSIVO){
-				//Comprobamos si es el propietario del bloqueo
-				if(mut.propietario == p_proc_actual->id){
-					//Disminuimos el numero de bloqueos
-					mut.bloqueado--;
-					if(mut.bloqueado == 0){
-						pr_bloqueado = lista_de_bloqueados.primero;
-						//Verificamos si hay algun proc en espera
-						if(pr_bloqueado != NULL){
-							//El proceso bloqueado lo ponemos en Listo despertandolo
-							pr_bloqueado->estado = LISTO;
-							nivel_anterior = fijar_nivel_int(NIVEL_3);
-							eliminar_primero(&lista_de_bloqueados);
-							insertar_ultimo(&lista_listos, pr_bloqueado);
-							fijar_nivel_int(nivel_anterior);
-						}
-					}
-				}else{
-					printk("ERROR: El mutex no tiene el mismo propietario que el proceso actual. \n");
-				}
-			}else if(mut.tipo == NO_RECURSIVO){
-				//Verificamos si es el propietario
-				if(mut.propietario == p_proc_actual->id){
-					//Desbloqueamos
-					mut.bloqueado--;
-					if(mut.bloqueado != 0){
-						printk("ERROR: No se ha desbloqueado el mutex no recursivo. \n");
-						
-						return -1;
-					}
-					pr_bloqueado = lista_de_bloqueados.primero;
-					//Verificamos si hay algun proceso en espera
-					if(pr_bloqueado != NULL){
-						pr_bloqueado->estado = LISTO;
-						nivel_anterior = fijar_nivel_int(NIVEL_3);
-						eliminar_primero(&lista_de_bloqueados);
-						insertar_ultimo(&lista_listos, pr_bloqueado);
-						fijar_nivel_int(nivel_anterior);
-					}
-				}else{
-					printk("ERROR: El mutex no tiene el mismo propietario que el proceso actual. \n");
-				}
-			}
-		}
-		//En caso de no estar bloqueado
-		else if(mut.bloqueado == 0){
-			printk("ERROR: Un mutex que no esta bloqueado no puede ser desbloqueado. \n");
-		}else{
-			printk("Otro error del mutex. \n");
-			
-			return -1;
-		}
+	tipo_descriptor *d;
+	mutex *mut;
+	int nivel;
+
+	//verificamos que el proceso tiene abierto el mutex
+	if((d = resolver_descriptor(mutexid, DESC_MUTEX)) == NULL){
+		printk_error("ERROR: por hacer unlock a un mutex no abierto \n");
+		return -1;
 	}
-	else{
-		printk("ERROR: por hacer unlock a un mutex no abierto \n");
-		
+	mut = &array_mutex[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(mut->bloqueado == 0){
+		fijar_nivel_int(nivel);
+		printk_error("ERROR: Un mutex que no esta bloqueado no puede ser desbloqueado. \n");
+		return -1;
+	}
+	if(mut->propietario != p_proc_actual->id){
+		fijar_nivel_int(nivel);
+		printk_error("ERROR: El mutex no tiene el mismo propietario que el proceso actual. \n");
 		return -1;
 	}
+	//Al soltar el ultimo bloqueo pasa al primero que espera, si lo hay
+	mut->bloqueado--;
+	if(mut->bloqueado == 0)
+		ceder_mutex(mut);
+	fijar_nivel_int(nivel);
 	
 	return 0;
 }
-//Para cerrar el mutex
-int sis_cerrar_mutex(){
-        unsigned int mutexid;
-	mutexid=(unsigned int)leer_registro(1);
-	
-	BCP * pr_bloqueado_mutex;
-	BCP * pr_bloqueado;
-	
-	//Comprobamos si existe el descriptor que se quiere cerrar
-	int existe = tiene_descriptor(mutexid);
-	if(existe < 0){
-		printk("No existe el mutex con el descriptor dado. \n");	
+//Lee de la memoria del usuario un conjunto de descriptores de mutex y deja
+//en mutexes los indices de los mutex ordenados de menor a mayor, que es el
+//orden canonico en el que se toman y se sueltan. Devuelve cuantos son o -1
+//si el conjunto no es valido o repite algun mutex
+static int leer_conjunto_mutex(int mutexes[]){
+	unsigned int *ids;
+	tipo_descriptor *d;
+	int n, i, j, m;
+
+	ids=(unsigned int *)leer_registro(1);
+	n=(int)leer_registro(2);
+	if (ids==NULL || n<1 || n>MAX_LOCK_MULTIPLE)
+		return -1;
+
+	for (i=0; i<n; i++){
+		if ((d=resolver_descriptor(ids[i], DESC_MUTEX))==NULL)
+			return -1;
+		m=d->objeto;
+		//Insercion ordenada, son pocos
+		for (j=i; j>0 && mutexes[j-1]>m; j--)
+			mutexes[j]=mutexes[j-1];
+		if (j>0 && mutexes[j-1]==m)
+			return -1;
+		mutexes[j]=m;
+	}
+	return n;
+}
+
+//Toma de una vez todos los mutex del conjunto. Mientras alguno lo tenga
+//otro proceso no toma ninguno: espera en lista_lock_multiple, apuntado en
+//cada mutex del conjunto, hasta que quien suelte uno se lo de entero, asi
+//que solo se despierta una vez. Los recursivos que ya son suyos cuentan
+//como libres
+int sis_lock_multiple(){
+	int mutexes[MAX_LOCK_MULTIPLE];
+	mutex *mut;
+	int n, i, nivel;
+
+	if((n = leer_conjunto_mutex(mutexes)) < 0){
+		printk_error("ERROR: conjunto de mutex no valido para lock_multiple \n");
 		return -1;
 	}
 
-	p_proc_actual->descriptores[existe].libre = 0;
-	if(array_mutex[mutexid].procesos_mutex <= 0){
-		printk("No existe el mutex que se quiere cerrar. \n");		
+	nivel = fijar_nivel_int(NIVEL_1);
+	for(i = 0; i < n; i++){
+		mut = &array_mutex[mutexes[i]];
+		if(mut->bloqueado && mut->propietario == p_proc_actual->id &&
+		   mut->tipo == NO_RECURSIVO){
+			fijar_nivel_int(nivel);
+			printk_error("Error debido a un interbloqueo.\n");
+			return -1;
+		}
+		p_proc_actual->conjunto_multiple[i] = mutexes[i];
+	}
+	p_proc_actual->n_multiple = n;
+	if(conjunto_disponible(p_proc_actual))
+		tomar_conjunto(p_proc_actual);
+	else {
+		//Al despertar ya tiene el conjunto entero
+		p_proc_actual->turno_espera = turno_mutex++;
+		for(i = 0; i < n; i++)
+			array_mutex[mutexes[i]].esperan_multiple |= (1U << p_proc_actual->id);
+		p_proc_actual->estado = BLOQUEADO;
+		cambio_proc(&lista_lock_multiple);
+	}
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Suelta todos los mutex del conjunto, en orden canonico inverso. Si alguno
+//no es suyo no suelta ninguno
+int sis_unlock_multiple(){
+	int mutexes[MAX_LOCK_MULTIPLE];
+	mutex *mut;
+	int n, i, nivel;
+
+	if((n = leer_conjunto_mutex(mutexes)) < 0){
+		printk_error("ERROR: conjunto de mutex no valido para unlock_multiple \n");
 		return -1;
 	}
-	
-	array_mutex[mutexid].procesos_mutex--;	
-	//Hay mutex disponible en caso de llegar a 0
-	if(array_mutex[mutexid].propietario == p_proc_actual->id){
-		array_mutex[mutexid].bloqueado = 0;
-		pr_bloqueado = lista_de_bloqueados.primero;
-		if(pr_bloqueado != NULL){
-		        //Cambio de contexto
-			pr_bloqueado->estado = LISTO;
-			nivel_anterior = fijar_nivel_int(NIVEL_3);
-			eliminar_primero(&lista_de_bloqueados);
-			insertar_ultimo(&lista_listos,pr_bloqueado);
-			fijar_nivel_int(nivel_anterior);
-			printk("Mutex cerrado. \n");
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	for(i = 0; i < n; i++){
+		mut = &array_mutex[mutexes[i]];
+		if(mut->bloqueado == 0 || mut->propietario != p_proc_actual->id){
+			fijar_nivel_int(nivel);
+			printk_error("ERROR: El mutex no tiene el mismo propietario que el proceso actual. \n");
+			return -1;
 		}
 	}
+	for(i = n-1; i >= 0; i--){
+		mut = &array_mutex[mutexes[i]];
+		mut->bloqueado--;
+		if(mut->bloqueado == 0)
+			ceder_mutex(mut);
+	}
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//El proceso actual deja de usar el mutex dado. Si era su propietario el
+//mutex se cede al primero que espera, y si ya nadie lo usa queda libre
+static void soltar_mutex(int m){
+	BCP * pr_bloqueado_mutex;
+	int nivel;
+	
+	nivel = fijar_nivel_int(NIVEL_1);
+	array_mutex[m].procesos_mutex--;	
+	//Si lo tenia bloqueado se libera entero, aunque sea recursivo
+	if(array_mutex[m].bloqueado > 0 && array_mutex[m].propietario == p_proc_actual->id){
+		ceder_mutex(&array_mutex[m]);
+		printk_depuracion("Mutex cerrado. \n");
+	}
 	
-	//En caso de el proceso mutex sea 0 y y no este bloqueado cerramos el mutex
-	if(array_mutex[mutexid].procesos_mutex == 0){
+	//Si ya nadie lo tiene abierto se borra su nombre y queda un hueco para
+	//quien espera crear uno
+	if(array_mutex[m].procesos_mutex == 0){
+		borrar_nombre(array_mutex[m].nombre, NOMBRE_MUTEX);
+		mutex_libres |= (1U << m);
 		pr_bloqueado_mutex = lista_de_mutex.primero;
 		//Verificamos si hay algun proceso esperando
 		if(pr_bloqueado_mutex != NULL){
-			pr_bloqueado_mutex->estado = LISTO;
-			nivel_anterior = fijar_nivel_int(NIVEL_3);
-			eliminar_primero(&lista_de_mutex);
-			insertar_ultimo(&lista_listos, pr_bloqueado_mutex);
-			fijar_nivel_int(nivel_anterior);
-			printk("Mutex cerrado. \n");
+			desbloquear(pr_bloqueado_mutex, &lista_de_mutex);
+			printk_depuracion("Mutex cerrado. \n");
 		}
 	}
+	fijar_nivel_int(nivel);
+}
+//Para cerrar el mutex
+int sis_cerrar_mutex(){
+        int mutexid;
+	mutexid=(int)leer_registro(1);
+	
+	tipo_descriptor *d;
+	int m;
+
+	//Comprobamos si existe el descriptor que se quiere cerrar
+	if((d = resolver_descriptor(mutexid, DESC_MUTEX)) == NULL){
+		printk_error("No existe el mutex con el descriptor dado. \n");	
+		return -1;
+	}
+	m = d->objeto;
+	liberar_descriptor(d);
+	soltar_mutex(m);
 	
 	return 0;
 }
 
+/*
+ * 
+ * Semaforos contadores con nombre
+ *
+ */
+//Crea un semaforo con el valor inicial dado y devuelve su descriptor
+int sis_crear_sem(){
+	char *nombre;
+	int valor, s;
 
-//Objetivo parcial 5
-//input, manejo basico de la entrada por teclado
-int leer_caracter(){
-	while(1){		      
-		 if(BufferChar != 0){
-		        int i;
-		        int nivel_int = fijar_nivel_int(NIVEL_2);
+	nombre=(char *)leer_registro(1);
+	valor=(int)leer_registro(2);
 
-		        // Saca el primer caracter
-		        char car = Buffer[0];
-				//quita una posicion en el buffer
-		        BufferChar--;
+	if(nombre == NULL || longitud_nombre(nombre) < 0 || valor < 0){
+		printk_error("ERROR: nombre o valor inicial de semaforo no valido. \n");
+		return -1;
+	}
+	if(p_proc_actual->descriptores_libres == 0 || sem_libres == 0){
+		printk_error("ERROR: no quedan descriptores o semaforos libres. \n");
+		return -1;
+	}
 
-		        // Coloca el buffer en orden
-		        for (i = 0; i < BufferChar; i++){
-		              Buffer[i] = Buffer[i + 1];
-		        }
+	s = __builtin_ffs(sem_libres) - 1;
+	if(registrar_nombre(nombre, NOMBRE_SEM, s) < 0){
+		printk_error("ERROR: ya existe un semaforo con este nombre. \n");
+		return -1;
+	}
+	sem_libres &= ~(1U << s);
+	strcpy(array_sem[s].nombre, nombre);
+	array_sem[s].valor = valor;
+	array_sem[s].procesos_sem = 1;
+
+	return asignar_descriptor(DESC_SEM, s);
+}
+
+//Abre un semaforo existente y devuelve su descriptor
+int sis_abrir_sem(){
+	char *nombre;
+	int s;
+
+	nombre=(char *)leer_registro(1);
+
+	if(p_proc_actual->descriptores_libres == 0){
+		printk_error("ERROR: no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+		return -1;
+	}
+	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+	   (s = buscar_nombre(nombre, NOMBRE_SEM)) < 0){
+		printk_error("ERROR: no existe el semaforo con ese nombre. \n");
+		return -1;
+	}
+	array_sem[s].procesos_sem++;
+
+	return asignar_descriptor(DESC_SEM, s);
+}
+
+//Decrementa el semaforo o, si esta a 0, espera en su cola hasta que un
+//senalizar_sem le pase directamente una unidad
+int sis_esperar_sem(){
+	tipo_descriptor *d;
+	semaforo *sem;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_SEM)) == NULL){
+		printk_error("ERROR: esperar_sem sobre un semaforo no abierto. \n");
+		return -1;
+	}
+	sem = &array_sem[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(sem->valor > 0)
+		sem->valor--;
+	else{
+		p_proc_actual->estado = BLOQUEADO;
+		cambio_proc(&sem->lista_espera);
+	}
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Suma n unidades al semaforo. Cada una despierta a uno de los que esperan,
+//que la recibe directamente, y las que sobran se suman al valor. Los
+//despertados pasan a listos en lote, comprobando la expropiacion solo
+//hasta que uno la provoca
+int sis_senalizar_sem(){
+	tipo_descriptor *d;
+	semaforo *sem;
+	BCP *proc;
+	int n, nivel;
+
+	d = resolver_descriptor((int)leer_registro(1), DESC_SEM);
+	n = (int)leer_registro(2);
+	if(d == NULL || n <= 0){
+		printk_error("ERROR: senalizar_sem no valido. \n");
+		return -1;
+	}
+	sem = &array_sem[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_3);
+	while(n > 0 && (proc = sem->lista_espera.primero) != NULL){
+		eliminar_primero(&sem->lista_espera);
+		poner_listo(proc);
+		if(!replanificacion_pendiente)
+			comprobar_expropiacion(proc);
+		n--;
+	}
+	sem->valor += n;
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//El proceso actual deja de usar el semaforo; si ya nadie lo usa queda libre
+static void soltar_sem(int s){
+	int nivel;
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	array_sem[s].procesos_sem--;
+	if(array_sem[s].procesos_sem == 0){
+		borrar_nombre(array_sem[s].nombre, NOMBRE_SEM);
+		sem_libres |= (1U << s);
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Cierra un semaforo
+int sis_cerrar_sem(){
+	tipo_descriptor *d;
+	int s;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_SEM)) == NULL){
+		printk_error("ERROR: no existe el semaforo con el descriptor dado. \n");
+		return -1;
+	}
+	s = d->objeto;
+	liberar_descriptor(d);
+	soltar_sem(s);
+
+	return 0;
+}
+
+/*
+ * 
+ * Variables condicion, asociadas en cada espera a un mutex
+ *
+ */
+//Crea una variable condicion y devuelve su descriptor
+int sis_crear_cond(){
+	char *nombre;
+	int c;
+
+	nombre=(char *)leer_registro(1);
+
+	if(nombre == NULL || longitud_nombre(nombre) < 0){
+		printk_error("ERROR: nombre de variable condicion no valido. \n");
+		return -1;
+	}
+	if(p_proc_actual->descriptores_libres == 0 || cond_libres == 0){
+		printk_error("ERROR: no quedan descriptores o variables condicion libres. \n");
+		return -1;
+	}
+
+	c = __builtin_ffs(cond_libres) - 1;
+	if(registrar_nombre(nombre, NOMBRE_COND, c) < 0){
+		printk_error("ERROR: ya existe una variable condicion con este nombre. \n");
+		return -1;
+	}
+	cond_libres &= ~(1U << c);
+	strcpy(array_cond[c].nombre, nombre);
+	array_cond[c].procesos_cond = 1;
+
+	return asignar_descriptor(DESC_COND, c);
+}
+
+//Abre una variable condicion existente y devuelve su descriptor
+int sis_abrir_cond(){
+	char *nombre;
+	int c;
+
+	nombre=(char *)leer_registro(1);
+
+	if(p_proc_actual->descriptores_libres == 0){
+		printk_error("ERROR: no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+		return -1;
+	}
+	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+	   (c = buscar_nombre(nombre, NOMBRE_COND)) < 0){
+		printk_error("ERROR: no existe la variable condicion con ese nombre. \n");
+		return -1;
+	}
+	array_cond[c].procesos_cond++;
+
+	return asignar_descriptor(DESC_COND, c);
+}
+
+//Suelta el mutex, con todos sus bloqueos si es recursivo, y espera en la
+//variable condicion. Al volver ya es otra vez propietario del mutex, que
+//le ha pasado directamente quien lo solto o quien le aviso
+int sis_cond_wait(){
+	tipo_descriptor *dc, *dm;
+	condicion *cond;
+	mutex *mut;
+	int nivel;
+
+	dc = resolver_descriptor((int)leer_registro(1), DESC_COND);
+	dm = resolver_descriptor((int)leer_registro(2), DESC_MUTEX);
+	if(dc == NULL || dm == NULL){
+		printk_error("ERROR: cond_wait sobre una variable condicion o mutex no abiertos. \n");
+		return -1;
+	}
+	cond = &array_cond[dc->objeto];
+	mut = &array_mutex[dm->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(mut->bloqueado == 0 || mut->propietario != p_proc_actual->id){
+		fijar_nivel_int(nivel);
+		printk_error("ERROR: cond_wait sin ser propietario del mutex. \n");
+		return -1;
+	}
+	p_proc_actual->mutex_cond = mut;
+	p_proc_actual->bloqueos_cond = mut->bloqueado;
+	mut->bloqueado = 0;
+	ceder_mutex(mut);
+
+	p_proc_actual->estado = BLOQUEADO;
+	cambio_proc(&cond->lista_espera);
+
+	//Recupera los bloqueos que tenia sobre el mutex
+	mut->bloqueado = p_proc_actual->bloqueos_cond;
+	p_proc_actual->mutex_cond = NULL;
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Saca de la variable condicion a un proceso que espera en ella. Si su
+//mutex esta libre se lo da y lo pone listo; si no, pasa directamente a la
+//cola del mutex sin despertarlo (wait morphing), y el propietario hereda
+//su prioridad como con cualquier otro que espera. Devuelve si lo ha
+//puesto listo
+static int avisar_cond(condicion *cond){
+	BCP *proc=cond->lista_espera.primero;
+	mutex *mut=proc->mutex_cond;
+	int nivel;
+
+	eliminar_primero(&cond->lista_espera);
+	if(mut->bloqueado == 0){
+		mut->propietario = proc->id;
+		mut->bloqueado = 1;
+		poner_listo(proc);
+		return 1;
+	}
+	proc->mutex_esperado = mut;
+	proc->turno_espera = turno_mutex++;
+	nivel = fijar_nivel_int(NIVEL_3);
+	insertar_ultimo(&mut->lista_espera, proc);
+	fijar_nivel_int(nivel);
+	recalcular_prioridad(&tabla_procs[mut->propietario]);
+	return 0;
+}
+
+//Avisa al primero de los que esperan en la variable condicion, si hay alguno
+int sis_cond_signal(){
+	tipo_descriptor *d;
+	condicion *cond;
+	BCP *proc;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_COND)) == NULL){
+		printk_error("ERROR: cond_signal sobre una variable condicion no abierta. \n");
+		return -1;
+	}
+	cond = &array_cond[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_3);
+	if((proc = cond->lista_espera.primero) != NULL && avisar_cond(cond))
+		comprobar_expropiacion(proc);
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Avisa a todos los que esperan en la variable condicion. Si quien avisa
+//tiene el mutex, todos pasan a su cola sin despertar y lo iran recibiendo
+//de uno en uno al soltarlo
+int sis_cond_broadcast(){
+	tipo_descriptor *d;
+	condicion *cond;
+	BCP *proc;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_COND)) == NULL){
+		printk_error("ERROR: cond_broadcast sobre una variable condicion no abierta. \n");
+		return -1;
+	}
+	cond = &array_cond[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_3);
+	while((proc = cond->lista_espera.primero) != NULL)
+		if(avisar_cond(cond) && !replanificacion_pendiente)
+			comprobar_expropiacion(proc);
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//El proceso actual deja de usar la variable condicion; si ya nadie la usa
+//queda libre
+static void soltar_cond(int c){
+	int nivel;
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	array_cond[c].procesos_cond--;
+	if(array_cond[c].procesos_cond == 0){
+		borrar_nombre(array_cond[c].nombre, NOMBRE_COND);
+		cond_libres |= (1U << c);
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Cierra una variable condicion
+int sis_cerrar_cond(){
+	tipo_descriptor *d;
+	int c;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_COND)) == NULL){
+		printk_error("ERROR: no existe la variable condicion con el descriptor dado. \n");
+		return -1;
+	}
+	c = d->objeto;
+	liberar_descriptor(d);
+	soltar_cond(c);
+
+	return 0;
+}
+
+/*
+ * 
+ * Cerrojos de lectores/escritores
+ *
+ */
+//Crea un cerrojo de lectores/escritores con la politica dada y devuelve
+//su descriptor
+int sis_crear_rwlock(){
+	char *nombre;
+	int politica, r;
+
+	nombre=(char *)leer_registro(1);
+	politica=(int)leer_registro(2);
+
+	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+	   (politica != PREFIERE_LECTORES && politica != PREFIERE_ESCRITORES)){
+		printk_error("ERROR: nombre o politica de cerrojo no validos. \n");
+		return -1;
+	}
+	if(p_proc_actual->descriptores_libres == 0 || rwlock_libres == 0){
+		printk_error("ERROR: no quedan descriptores o cerrojos libres. \n");
+		return -1;
+	}
+
+	r = __builtin_ffs(rwlock_libres) - 1;
+	if(registrar_nombre(nombre, NOMBRE_RWLOCK, r) < 0){
+		printk_error("ERROR: ya existe un cerrojo con este nombre. \n");
+		return -1;
+	}
+	rwlock_libres &= ~(1U << r);
+	strcpy(array_rwlock[r].nombre, nombre);
+	array_rwlock[r].politica = politica;
+	array_rwlock[r].procesos_rw = 1;
+	array_rwlock[r].lectores = 0;
+	array_rwlock[r].mapa_lectores = 0;
+	array_rwlock[r].escritor = -1;
+	array_rwlock[r].esperas_lectores = 0;
+	array_rwlock[r].ticks_lectores = 0;
+	array_rwlock[r].esperas_escritores = 0;
+	array_rwlock[r].ticks_escritores = 0;
+
+	return asignar_descriptor(DESC_RWLOCK, r);
+}
+
+//Abre un cerrojo de lectores/escritores existente y devuelve su descriptor
+int sis_abrir_rwlock(){
+	char *nombre;
+	int r;
+
+	nombre=(char *)leer_registro(1);
+
+	if(p_proc_actual->descriptores_libres == 0){
+		printk_error("ERROR: no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+		return -1;
+	}
+	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+	   (r = buscar_nombre(nombre, NOMBRE_RWLOCK)) < 0){
+		printk_error("ERROR: no existe el cerrojo con ese nombre. \n");
+		return -1;
+	}
+	array_rwlock[r].procesos_rw++;
+
+	return asignar_descriptor(DESC_RWLOCK, r);
+}
+
+//Indica si el proceso actual esta dentro del cerrojo, leyendo o escribiendo
+static int dentro_rwlock(cerrojo_rw *rw){
+	return rw->escritor == p_proc_actual->id ||
+		(rw->mapa_lectores & (1U << p_proc_actual->id));
+}
+
+//Entra a leer. Con preferencia de lectores solo espera si hay un escritor
+//dentro; con preferencia de escritores tambien si alguno esta esperando
+int sis_lock_lector(){
+	tipo_descriptor *d;
+	cerrojo_rw *rw;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_RWLOCK)) == NULL){
+		printk_error("ERROR: lock_lector sobre un cerrojo no abierto. \n");
+		return -1;
+	}
+	rw = &array_rwlock[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(dentro_rwlock(rw)){
+		fijar_nivel_int(nivel);
+		printk_error("Error debido a un interbloqueo.\n");
+		return -1;
+	}
+	if(rw->escritor == -1 &&
+	   (rw->politica == PREFIERE_LECTORES || rw->escritores_espera.primero == NULL)){
+		rw->lectores++;
+		rw->mapa_lectores |= (1U << p_proc_actual->id);
+	}else{
+		//Quien le deje pasar lo cuenta ya como lector
+		p_proc_actual->estado = BLOQUEADO;
+		p_proc_actual->instante_bloqueo = n_interrup;
+		cambio_proc(&rw->lectores_espera);
+	}
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Entra a escribir si no hay nadie dentro y si no espera su turno
+int sis_lock_escritor(){
+	tipo_descriptor *d;
+	cerrojo_rw *rw;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_RWLOCK)) == NULL){
+		printk_error("ERROR: lock_escritor sobre un cerrojo no abierto. \n");
+		return -1;
+	}
+	rw = &array_rwlock[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(dentro_rwlock(rw)){
+		fijar_nivel_int(nivel);
+		printk_error("Error debido a un interbloqueo.\n");
+		return -1;
+	}
+	if(rw->escritor == -1 && rw->lectores == 0)
+		rw->escritor = p_proc_actual->id;
+	else{
+		p_proc_actual->estado = BLOQUEADO;
+		p_proc_actual->instante_bloqueo = n_interrup;
+		cambio_proc(&rw->escritores_espera);
+	}
+	fijar_nivel_int(nivel);
+
+	return 0;
+}
+
+//Deja entrar de una vez a todos los lectores que esperan, pasandolos a
+//listos en lote
+static void admitir_lectores(cerrojo_rw *rw){
+	BCP *proc;
+
+	while((proc = rw->lectores_espera.primero) != NULL){
+		eliminar_primero(&rw->lectores_espera);
+		rw->lectores++;
+		rw->mapa_lectores |= (1U << proc->id);
+		rw->esperas_lectores++;
+		rw->ticks_lectores += n_interrup - proc->instante_bloqueo;
+		poner_listo(proc);
+		if(!replanificacion_pendiente)
+			comprobar_expropiacion(proc);
+	}
+}
+
+//Deja entrar al primer escritor que espera
+static void admitir_escritor(cerrojo_rw *rw){
+	BCP *proc=rw->escritores_espera.primero;
+
+	eliminar_primero(&rw->escritores_espera);
+	rw->escritor = proc->id;
+	rw->esperas_escritores++;
+	rw->ticks_escritores += n_interrup - proc->instante_bloqueo;
+	desbloquear(proc, NULL);
+}
+
+//Saca al proceso actual del cerrojo. Al salir un escritor entran todos los
+//lectores que esperan o, si no hay, el siguiente escritor; al salir el
+//ultimo lector entra el siguiente escritor. Asi, aun prefiriendo a los
+//escritores, los lectores que llegaron durante una escritura entran antes
+//que la siguiente
+static void salir_rwlock(cerrojo_rw *rw){
+	int nivel;
+
+	nivel = fijar_nivel_int(NIVEL_3);
+	if(rw->escritor == p_proc_actual->id){
+		rw->escritor = -1;
+		if(rw->lectores_espera.primero != NULL)
+			admitir_lectores(rw);
+		else if(rw->escritores_espera.primero != NULL)
+			admitir_escritor(rw);
+	}else{
+		rw->lectores--;
+		rw->mapa_lectores &= ~(1U << p_proc_actual->id);
+		if(rw->lectores == 0 && rw->escritores_espera.primero != NULL)
+			admitir_escritor(rw);
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Sale del cerrojo, tanto si estaba leyendo como escribiendo
+int sis_unlock_rwlock(){
+	tipo_descriptor *d;
+	cerrojo_rw *rw;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_RWLOCK)) == NULL){
+		printk_error("ERROR: unlock_rwlock sobre un cerrojo no abierto. \n");
+		return -1;
+	}
+	rw = &array_rwlock[d->objeto];
+
+	if(!dentro_rwlock(rw)){
+		printk_error("ERROR: el proceso no esta dentro del cerrojo. \n");
+		return -1;
+	}
+	salir_rwlock(rw);
+
+	return 0;
+}
+
+//El proceso actual deja de usar el cerrojo, saliendo de el si estaba
+//dentro; si ya nadie lo usa queda libre
+static void soltar_rwlock(int r){
+	int nivel;
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	if(dentro_rwlock(&array_rwlock[r]))
+		salir_rwlock(&array_rwlock[r]);
+	array_rwlock[r].procesos_rw--;
+	if(array_rwlock[r].procesos_rw == 0){
+		borrar_nombre(array_rwlock[r].nombre, NOMBRE_RWLOCK);
+		rwlock_libres |= (1U << r);
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Cierra un cerrojo de lectores/escritores
+int sis_cerrar_rwlock(){
+	tipo_descriptor *d;
+	int r;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_RWLOCK)) == NULL){
+		printk_error("ERROR: no existe el cerrojo con el descriptor dado. \n");
+		return -1;
+	}
+	r = d->objeto;
+	liberar_descriptor(d);
+	soltar_rwlock(r);
+
+	return 0;
+}
+
+//Rellena los accesos de cada tipo que han esperado en el cerrojo y los
+//ticks esperados en total, para ajustar la politica
+int sis_esperas_rwlock(){
+	tipo_descriptor *d;
+	struct esperas_rwlock *esperas;
+	cerrojo_rw *rw;
+
+	d = resolver_descriptor((int)leer_registro(1), DESC_RWLOCK);
+	esperas = (struct esperas_rwlock *)leer_registro(2);
+	if(d == NULL || esperas == NULL){
+		printk_error("ERROR: esperas_rwlock no valido. \n");
+		return -1;
+	}
+	rw = &array_rwlock[d->objeto];
+	esperas->esperas_lectores = rw->esperas_lectores;
+	esperas->ticks_lectores = rw->ticks_lectores;
+	esperas->esperas_escritores = rw->esperas_escritores;
+	esperas->ticks_escritores = rw->ticks_escritores;
+
+	return 0;
+}
+
+/*
+ * 
+ * Barreras
+ *
+ */
+//Crea una barrera para n procesos y devuelve su descriptor
+int sis_crear_barrera(){
+	char *nombre;
+	int n, b;
+
+	nombre=(char *)leer_registro(1);
+	n=(int)leer_registro(2);
+
+	if(nombre == NULL || longitud_nombre(nombre) < 0 || n < 1 || n > MAX_PROC){
+		printk_error("ERROR: nombre o numero de procesos de barrera no validos. \n");
+		return -1;
+	}
+	if(p_proc_actual->descriptores_libres == 0 || barrera_libres == 0){
+		printk_error("ERROR: no quedan descriptores o barreras libres. \n");
+		return -1;
+	}
+
+	b = __builtin_ffs(barrera_libres) - 1;
+	if(registrar_nombre(nombre, NOMBRE_BARRERA, b) < 0){
+		printk_error("ERROR: ya existe una barrera con este nombre. \n");
+		return -1;
+	}
+	barrera_libres &= ~(1U << b);
+	strcpy(array_barrera[b].nombre, nombre);
+	array_barrera[b].n = n;
+	array_barrera[b].llegados = 0;
+	array_barrera[b].procesos_barrera = 1;
+
+	return asignar_descriptor(DESC_BARRERA, b);
+}
+
+//Abre una barrera existente y devuelve su descriptor
+int sis_abrir_barrera(){
+	char *nombre;
+	int b;
+
+	nombre=(char *)leer_registro(1);
+
+	if(p_proc_actual->descriptores_libres == 0){
+		printk_error("ERROR: no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+		return -1;
+	}
+	if(nombre == NULL || longitud_nombre(nombre) < 0 ||
+	   (b = buscar_nombre(nombre, NOMBRE_BARRERA)) < 0){
+		printk_error("ERROR: no existe la barrera con ese nombre. \n");
+		return -1;
+	}
+	array_barrera[b].procesos_barrera++;
+
+	return asignar_descriptor(DESC_BARRERA, b);
+}
+
+//Espera a que lleguen a la barrera los n procesos. El ultimo en llegar no
+//espera: pasa a listos de una vez a todos los demas, comprobando la
+//expropiacion solo hasta que uno la provoca, deja la barrera lista para
+//la siguiente ronda y recibe BARRERA_ULTIMO
+int sis_esperar_barrera(){
+	tipo_descriptor *d;
+	barrera *bar;
+	BCP *proc;
+	int nivel;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_BARRERA)) == NULL){
+		printk_error("ERROR: esperar_barrera sobre una barrera no abierta. \n");
+		return -1;
+	}
+	bar = &array_barrera[d->objeto];
+
+	nivel = fijar_nivel_int(NIVEL_3);
+	if(++bar->llegados < bar->n){
+		p_proc_actual->estado = BLOQUEADO;
+		cambio_proc(&bar->lista_espera);
+		fijar_nivel_int(nivel);
+		return 0;
+	}
+	bar->llegados = 0;
+	while((proc = bar->lista_espera.primero) != NULL){
+		eliminar_primero(&bar->lista_espera);
+		poner_listo(proc);
+		if(!replanificacion_pendiente)
+			comprobar_expropiacion(proc);
+	}
+	fijar_nivel_int(nivel);
+
+	return BARRERA_ULTIMO;
+}
+
+//El proceso actual deja de usar la barrera; si ya nadie la usa queda libre
+static void soltar_barrera(int b){
+	int nivel;
+
+	nivel = fijar_nivel_int(NIVEL_1);
+	array_barrera[b].procesos_barrera--;
+	if(array_barrera[b].procesos_barrera == 0){
+		borrar_nombre(array_barrera[b].nombre, NOMBRE_BARRERA);
+		barrera_libres |= (1U << b);
+	}
+	fijar_nivel_int(nivel);
+}
+
+//Cierra una barrera
+int sis_cerrar_barrera(){
+	tipo_descriptor *d;
+	int b;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_BARRERA)) == NULL){
+		printk_error("ERROR: no existe la barrera con el descriptor dado. \n");
+		return -1;
+	}
+	b = d->objeto;
+	liberar_descriptor(d);
+	soltar_barrera(b);
+
+	return 0;
+}
+
+//Cierre implicito de todos los descriptores que siga teniendo abiertos el
+//proceso actual, segun el tipo de objeto de cada uno
+static void cerrar_descriptores(){
+	unsigned int abiertos=~p_proc_actual->descriptores_libres;
+	tipo_descriptor *d;
+	int i;
+
+	while (abiertos){
+		i=__builtin_ffs(abiertos)-1;
+		abiertos &= ~(1U << i);
+		d=&p_proc_actual->descriptores[i];
+		if (d->tipo==DESC_MUTEX)
+			soltar_mutex(d->objeto);
+		else if (d->tipo==DESC_SEM)
+			soltar_sem(d->objeto);
+		else if (d->tipo==DESC_COND)
+			soltar_cond(d->objeto);
+		else if (d->tipo==DESC_RWLOCK)
+			soltar_rwlock(d->objeto);
+		else if (d->tipo==DESC_BARRERA)
+			soltar_barrera(d->objeto);
+		liberar_descriptor(d);
+	}
+}
+
+
+//Saca el primer caracter del buffer del terminal, que no puede estar
+//vacio. Se llama con las interrupciones del terminal inhibidas
+static char sacar_caracter(){
+	char car;
+
+	car = buffer_terminal[cabeza_terminal & MASCARA_BUF_TERMINAL];
+	cabeza_terminal++;
+	if(car == '\n')
+		lineas_terminal--;
+	return car;
+}
+
+//Objetivo parcial 5
+//input, manejo basico de la entrada por teclado
+int leer_caracter(){
+	int nivel;
+	char car;
+
+	nivel = fijar_nivel_int(NIVEL_2);
+	p_proc_actual->lectura_canonica = 0;
+	//Si el buffer no tiene nada lo bloqueamos en la cola de lectores,
+	//donde lo despierta int_terminal. Puede que al despertar otro lector
+	//se haya llevado el caracter; en ese caso vuelve a esperar
+	while(cola_terminal == cabeza_terminal){
+		p_proc_actual->estado = BLOQUEADO;
+		subir_nivel_mlfq();
+		cambio_proc(&lista_lectores);
+	}
+	car = sacar_caracter();
+	despertar_lector();
+	fijar_nivel_int(nivel);
+
+	return (long)car;
+}
+
+//Lee un caracter esperando como mucho el plazo en ticks indicado. Si
+//vence sin que haya llegado ninguno devuelve -1
+int sis_leer_caracter_timeout(){
+	unsigned int ticks, limite;
+	int nivel, nivel_reloj, vencido=0;
+	char car;
+
+	ticks=(unsigned int)leer_registro(1);
+	if(ticks > MAX_PLAZO){
+		printk_error("ERROR: plazo de leer_caracter_timeout no valido. \n");
+		return -1;
+	}
+	limite = n_interrup + ticks;
+
+	//Puede que al despertar otro lector se haya llevado el caracter; en
+	//ese caso se sigue esperando lo que quede del plazo
+	nivel = fijar_nivel_int(NIVEL_2);
+	p_proc_actual->lectura_canonica = 0;
+	while(cola_terminal == cabeza_terminal && !vencido){
+		//Con el reloj inhibido, que saca de la lista a los lectores que
+		//vencen y no debe pasar el plazo entre la comprobacion y la espera
+		nivel_reloj = fijar_nivel_int(NIVEL_3);
+		if((int)(limite - (unsigned int)n_interrup) <= 0)
+			vencido = 1;
+		else {
+			subir_nivel_mlfq();
+			insertar_ultimo(&lista_lectores, p_proc_actual);
+			if(esperar_con_plazo(&lista_lectores, limite - n_interrup) < 0)
+				vencido = 1;
+		}
+		fijar_nivel_int(nivel_reloj);
+	}
+	if(vencido){
+		fijar_nivel_int(nivel);
+		return -1;
+	}
+	car = sacar_caracter();
+	despertar_lector();
+	fijar_nivel_int(nivel);
+
+	return (long)car;
+}
+
+//Lee hasta n caracteres del terminal de una vez. En modo crudo
+//espera a que haya alguno y devuelve todos los que haya; en modo canonico
+//espera a una linea completa, que devuelve con su fin de linea, o a que
+//haya n caracteres (o el buffer este lleno, si n no cabe). El modo de la
+//ultima lectura es el del terminal: en canonico int_terminal edita la
+//linea en curso. Devuelve los caracteres leidos
+static int leer_modo(char *buf, unsigned int n, int modo){
+	unsigned int leidos;
+	int nivel;
+	char car;
+
+	if(n == 0)
+		return 0;
+
+	nivel = fijar_nivel_int(NIVEL_2);
+	canonico_terminal = (modo == LEER_CANONICO);
+	p_proc_actual->lectura_canonica = canonico_terminal;
+	p_proc_actual->lectura_minima = n < TAM_BUF_TERMINAL ? n : TAM_BUF_TERMINAL;
+	//Se le despierta una sola vez, cuando ya tiene lo que necesita, salvo
+	//que otro lector se lo haya llevado antes
+	while(!lectura_lista(p_proc_actual)){
+		p_proc_actual->estado = BLOQUEADO;
+		subir_nivel_mlfq();
+		cambio_proc(&lista_lectores);
+	}
+	leidos = 0;
+	while(leidos < n && cola_terminal != cabeza_terminal){
+		car = sacar_caracter();
+		buf[leidos++] = car;
+		if(car == '\n' && modo == LEER_CANONICO)
+			break;
+	}
+	despertar_lector();
+	fijar_nivel_int(nivel);
+
+	return leidos;
+}
+
+//Llamada leer: lectura del terminal en el modo indicado
+int sis_leer(){
+	char *buf;
+	unsigned int n;
+	int modo;
+
+	buf=(char *)leer_registro(1);
+	n=(unsigned int)leer_registro(2);
+	modo=(int)leer_registro(3);
+	if(modo != LEER_CRUDO && modo != LEER_CANONICO){
+		printk_error("ERROR: modo de leer no valido. \n");
+		return -1;
+	}
+	return leer_modo(buf, n, modo);
+}
+
+//Copia en el buffer del usuario hasta n bytes de la consola que aun no
+//haya leido con leer_log, sin esperar, y devuelve cuantos. Si se ha
+//quedado atras mas de TAM_CONSOLA bytes, lo mas antiguo ya se ha perdido
+int sis_leer_log(){
+	char *buf;
+	unsigned int n, i;
+	int nivel;
+
+	buf=(char *)leer_registro(1);
+	n=(unsigned int)leer_registro(2);
+
+	nivel=fijar_nivel_int(NIVEL_3);
+	if(cola_consola - lectura_log > TAM_CONSOLA)
+		lectura_log = cola_consola - TAM_CONSOLA;
+	if(n > cola_consola - lectura_log)
+		n = cola_consola - lectura_log;
+	for(i = 0; i < n; i++)
+		buf[i] = buffer_consola[lectura_log++ & (TAM_CONSOLA-1)];
+	fijar_nivel_int(nivel);
+
+	return n;
+}
+
+//Fija el nivel maximo de los mensajes del nucleo que se muestran y
+//devuelve el anterior. Los que se han quitado al compilar no vuelven
+int sis_fijar_umbral_log(){
+	int nivel, anterior;
+
+	nivel=(int)leer_registro(1);
+	if(nivel < LOG_ERROR || nivel > LOG_TRAZA){
+		printk_error("ERROR: nivel de log %d no valido. \n", nivel);
+		return -1;
+	}
+	anterior=umbral_log;
+	umbral_log=nivel;
+	return anterior;
+}
+
+//Devuelve los caracteres del terminal que se han perdido por llegar con
+//el buffer lleno
+int sis_caracteres_perdidos(){
+	return perdidos_terminal;
+}
+
+/*
+ *
+ * Dispositivos de caracteres: manejadores y llamadas
+ *
+ */
+
+//Terminal: se lee en el modo en que este, como con leer, y se escribe en
+//pantalla
+int leer_terminal(char *buf, unsigned int n){
+	return leer_modo(buf, n, canonico_terminal ? LEER_CANONICO : LEER_CRUDO);
+}
+int escribir_terminal(char *buf, unsigned int n){
+	escribir_consola(buf, n);
+	return n;
+}
+int sondear_terminal(){
+	return cola_terminal != cabeza_terminal;
+}
+
+//Nulo: descarta lo que se escribe y al leer da fin de fichero
+int leer_nulo(char *buf, unsigned int n){
+	return 0;
+}
+int escribir_nulo(char *buf, unsigned int n){
+	return n;
+}
+
+//Cero: al leer da tantos ceros como se pidan
+int leer_cero(char *buf, unsigned int n){
+	memset(buf, 0, n);
+	return n;
+}
+
+//Eco: devuelve lo que se le escribe sin esperar nunca. Al leer da lo que
+//haya, hasta n bytes, y al escribir guarda lo que quepa
+int leer_eco(char *buf, unsigned int n){
+	unsigned int i, disponibles = cola_eco - cabeza_eco;
+
+	if(n > disponibles)
+		n = disponibles;
+	for(i = 0; i < n; i++)
+		buf[i] = buffer_eco[cabeza_eco++ & (TAM_BUF_ECO-1)];
+	return n;
+}
+int escribir_eco(char *buf, unsigned int n){
+	unsigned int i, libres = TAM_BUF_ECO - (cola_eco - cabeza_eco);
+
+	if(n > libres)
+		n = libres;
+	for(i = 0; i < n; i++)
+		buffer_eco[cola_eco++ & (TAM_BUF_ECO-1)] = buf[i];
+	return n;
+}
+int sondear_eco(){
+	return cola_eco != cabeza_eco;
+}
+
+//Para los que siempre se pueden leer sin esperar
+int sondear_siempre(){
+	return 1;
+}
+
+//Abre el dispositivo con el nombre dado y devuelve su descriptor
+int sis_abrir_dispositivo(){
+	char *nombre;
+	int disp;
+
+	nombre=(char *)leer_registro(1);
+
+	if(p_proc_actual->descriptores_libres == 0){
+		printk_error("ERROR: no hay descriptores libres para el proceso %d\n", p_proc_actual->id);
+		return -1;
+	}
+	if(nombre != NULL && longitud_nombre(nombre) >= 0)
+		for(disp = 0; disp < NUM_DISPOSITIVOS; disp++)
+			if(strcmp(tabla_dispositivos[disp].nombre, nombre) == 0)
+				return asignar_descriptor(DESC_DISPOSITIVO, disp);
+	printk_error("ERROR: no existe el dispositivo con ese nombre. \n");
+	return -1;
+}
+
+//Lee o escribe hasta n bytes en el dispositivo con su manejador y devuelve
+//cuantos ha leido o escrito
+int sis_leer_dispositivo(){
+	tipo_descriptor *d;
 
-		        fijar_nivel_int(nivel_int);
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_DISPOSITIVO)) == NULL){
+		printk_error("ERROR: no existe el dispositivo con el descriptor dado. \n");
+		return -1;
+	}
+	return tabla_dispositivos[d->objeto].leer((char *)leer_registro(2),
+		(unsigned int)leer_registro(3));
+}
+int sis_escribir_dispositivo(){
+	tipo_descriptor *d;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_DISPOSITIVO)) == NULL){
+		printk_error("ERROR: no existe el dispositivo con el descriptor dado. \n");
+		return -1;
+	}
+	return tabla_dispositivos[d->objeto].escribir((char *)leer_registro(2),
+		(unsigned int)leer_registro(3));
+}
+
+//Indica si se puede leer del dispositivo sin esperar
+int sis_sondear_dispositivo(){
+	tipo_descriptor *d;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_DISPOSITIVO)) == NULL){
+		printk_error("ERROR: no existe el dispositivo con el descriptor dado. \n");
+		return -1;
+	}
+	return tabla_dispositivos[d->objeto].sondear();
+}
+
+//Los dispositivos no tienen estado por proceso: cerrar solo libera el
+//descriptor
+int sis_cerrar_dispositivo(){
+	tipo_descriptor *d;
+
+	if((d = resolver_descriptor((int)leer_registro(1), DESC_DISPOSITIVO)) == NULL){
+		printk_error("ERROR: no existe el dispositivo con el descriptor dado. \n");
+		return -1;
+	}
+	liberar_descriptor(d);
+	return 0;
+}
+
+//Prioridades
+//Fija la prioridad del proceso actual y devuelve la que tenia.
+//Si al bajarla queda algun proceso listo mas prioritario, cede el procesador
+int sis_fijar_prioridad(){
+	int prioridad, anterior;
+
+	prioridad=(int)leer_registro(1);
+	if (prioridad < PRIO_MIN || prioridad > PRIO_MAX){
+		printk_error("ERROR: prioridad %d fuera de rango. \n", prioridad);
+		return -1;
+	}
+
+	//Si hereda una prioridad mayor la conserva hasta soltar el mutex
+	anterior = p_proc_actual->prioridad_base;
+	p_proc_actual->prioridad_base = prioridad;
+	aplicar_prioridad(p_proc_actual, prioridad_efectiva(p_proc_actual));
+	return anterior;
+}
+
+//Devuelve cuantas veces un propietario de mutex ha heredado la prioridad
+//de un proceso que lo esperaba
+int sis_herencias_prioridad(){
+	return herencias_prioridad;
+}
+
+//Pide que se aplace (activar distinto de 0) o deja de pedir que se aplace
+//la expulsion del proceso al acabar su rodaja, para secciones criticas de
+//usuario. Solo tiene efecto si hay prorroga (PRORROGA_MUTEX > 0)
+int sis_aplazar_expulsion(){
+	int nivel;
+
+	nivel=fijar_nivel_int(NIVEL_3);
+	p_proc_actual->aplazar_expulsion=(leer_registro(1)!=0);
+	ceder_prorroga();
+	fijar_nivel_int(nivel);
+	return 0;
+}
+
+//Rellena las prorrogas concedidas, los ticks que han durado y las cedidas
+//antes de agotarlas, y devuelve las concedidas
+int sis_prorrogas(){
+	struct prorrogas *p;
 
-	                return (long)car;
+	p=(struct prorrogas *)leer_registro(1);
+	if (p!=NULL){
+		p->concedidas=prorrogas_concedidas;
+		p->ticks=ticks_prorroga;
+		p->cedidas=prorrogas_cedidas;
+	}
+	return prorrogas_concedidas;
+}
 
-		 }else{
-			// Si el buffer no tiene nada lo bloqueamos
-			p_proc_actual->estado = BLOQUEADO;
-			p_proc_actual->blocLectura = 1;
-				//ponemos nivel de bloqueo
-			int nivel_int = fijar_nivel_int(NIVEL_3);
-			//eliminamos el proceso actualde la lista de listos
-			eliminar_elem(&lista_listos, p_proc_actual);
-			insertar_ultimo(&lista_dormidos, p_proc_actual);
-			fijar_nivel_int(nivel_int);
-			nivel_int = fijar_nivel_int(NIVEL_2);
-			//bloqua el proceso actual
-			BCP *proceso_bloqueado = p_proc_actual;
-			//llama al planificador
-			p_proc_actual = planificador();
-			//cambia de contexto
-			cambio_contexto(&(proceso_bloqueado->contexto_regs), &(p_proc_actual->contexto_regs));
-			fijar_nivel_int(nivel_int);
-	         }
+//EDF: pasa el proceso actual a la clase EDF con el periodo, presupuesto y
+//plazo relativo dados en ticks, si la utilizacion total no supera el 100%.
+//Ninguno puede pasar de MAX_PLAZO, como los plazos del resto de llamadas.
+//Con periodo 0 vuelve a la politica normal. El primer periodo empieza ya
+int sis_fijar_edf(){
+	int periodo, presupuesto, plazo, utilizacion;
+
+	periodo=(int)leer_registro(1);
+	presupuesto=(int)leer_registro(2);
+	plazo=(int)leer_registro(3);
+
+	if (periodo==0){
+		if (p_proc_actual->edf){
+			utilizacion_edf -= p_proc_actual->utilizacion;
+			p_proc_actual->edf=0;
+		}
+		return 0;
 	}
+	if (periodo < 0 || (unsigned int)periodo > MAX_PLAZO || presupuesto <= 0 ||
+	    plazo < presupuesto || plazo > periodo){
+		printk_error("ERROR: parametros EDF no validos. \n");
+		return -1;
+	}
+
+	//Control de admision, redondeando la utilizacion por exceso. El
+	//producto no cabe en un int para presupuestos grandes
+	utilizacion=(int)(((unsigned long long)presupuesto*UTIL_ESCALA+periodo-1)/periodo);
+	if (utilizacion_edf - (p_proc_actual->edf ? p_proc_actual->utilizacion : 0)
+	    + utilizacion > UTIL_ESCALA){
+		printk_error("ERROR: EDF rechazado, utilizacion por encima del 100%%. \n");
+		return -1;
+	}
+
+	if (p_proc_actual->edf)
+		utilizacion_edf -= p_proc_actual->utilizacion;
+	utilizacion_edf += utilizacion;
+	p_proc_actual->edf=1;
+	p_proc_actual->utilizacion=utilizacion;
+	p_proc_actual->periodo=periodo;
+	p_proc_actual->presupuesto=presupuesto;
+	p_proc_actual->plazo_relativo=plazo;
+	p_proc_actual->presupuesto_restante=presupuesto;
+	p_proc_actual->plazo_absoluto=n_interrup+plazo;
+	p_proc_actual->siguiente_activacion=n_interrup+periodo;
+	p_proc_actual->pendiente=1;
+
+	//Si hay un EDF listo con plazo anterior debe ejecutar el primero
+	if (monticulo_edf.raiz!=NULL){
+		replanificacion_pendiente=1;
+		activar_int_SW();
+	}
+	return 0;
+}
+
+//EDF: devuelve el numero de plazos incumplidos por el proceso actual
+int sis_fallos_plazo(){
+	return p_proc_actual->fallos_plazo;
+}
+
+//Stride: fija los tickets del proceso actual y devuelve los que tenia.
+//La nueva zancada se aplica a partir del siguiente tick
+int sis_fijar_tickets(){
+	int tickets, anterior;
+
+	tickets=(int)leer_registro(1);
+	if (tickets < 1 || tickets > MAX_TICKETS){
+		printk_error("ERROR: numero de tickets %d fuera de rango. \n", tickets);
+		return -1;
+	}
+
+	anterior = p_proc_actual->tickets;
+	p_proc_actual->tickets = tickets;
+	p_proc_actual->zancada = ZANCADA_BASE/tickets;
+	return anterior;
 }
 
 
 
 /*
  *
- * Rutina de inicializacin invocada en arranque
+ * Rutina de inicialización invocada en arranque
  *
  */
 int main(){
 	/* se llega con las interrupciones prohibidas */
 
         iniciar_tabla_proc();		/* inicia BCPs de tabla de procesos */
+        iniciar_nombres();		/* inicia el espacio de nombres */
 		//inicia las excepciones
 	instal_man_int(EXC_ARITM, exc_arit); 
 	instal_man_int(EXC_MEM, exc_mem); 
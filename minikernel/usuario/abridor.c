@@ -1,9 +1,9 @@
 /*
  * usuario/abridor.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -35,9 +35,9 @@ int main(){
 	if (abrir_mutex("m4")<0)
 		printf("error abriendo m4. NO DEBE SALIR\n");
 
-	/* Error: ha agotado los descriptores */
+	/* la tabla de descriptores admite mas de 4 mutex abiertos */
 	if (abrir_mutex("m5")<0)
-		printf("error abriendo m5. DEBE SALIR\n");
+		printf("error abriendo m5. NO DEBE SALIR\n");
 
 	/* libera un descriptor de mutex (m1) */
 	cerrar_mutex(desc);
@@ -45,7 +45,7 @@ int main(){
 	/* Agotado num mutex del sistema. Debe bloquearse */
 	if (crear_mutex("m17", 0)<0)
 		printf("error creando m17. NO DEBE SALIR\n");
-	/* se desbloquear cuando se elimine m1 */
+	/* se desbloqueará cuando se elimine m1 */
 
 	/* intenta crear el mismo mutex: devuelve un error porque ya existe */
 	if (crear_mutex("m17", 0)<0)
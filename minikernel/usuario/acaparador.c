@@ -0,0 +1,50 @@
+/*
+ * usuario/acaparador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que crea el mutex "plazo" de prueba_plazos, lo toma,
+ * avisa por el semaforo "listo" y lo suelta a los ACAPARA ticks. Despues
+ * hace RONDAS en las que lo toma, avisa y lo suelta en torno al tick en que
+ * vence el lock_timeout(PLAZO_CORTO) de prueba_plazos: uno antes, en el
+ * mismo o uno despues. Al acabar avisa por el semaforo "hecho".
+ */
+
+#include "servicios.h"
+
+#define ACAPARA 50
+#define PLAZO_CORTO 10	/* lo mismo que en prueba_plazos */
+#define RONDAS 12
+
+int main(){
+	int plazo, listo, hecho, i;
+
+	if ((plazo=crear_mutex("plazo", NO_RECURSIVO))<0 || (listo=abrir_sem("listo"))<0 ||
+	    (hecho=abrir_sem("hecho"))<0){
+		printf("acaparador: error creando objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	lock(plazo);
+	senalizar_sem(listo, 1);
+	dormir_ticks(ACAPARA);
+	unlock(plazo);
+
+	for (i=0; i<RONDAS; i++){
+		lock(plazo);
+		senalizar_sem(listo, 1);
+		dormir_ticks(PLAZO_CORTO-1+i%3);
+		if (unlock(plazo)<0)
+			printf("acaparador: unlock falla en la ronda %d. NO DEBE APARECER\n", i);
+	}
+	senalizar_sem(hecho, 1);
+
+	/* mantiene el mutex abierto hasta que prueba_plazos lo haya usado */
+	dormir_ticks(ACAPARA);
+	return 0;
+}
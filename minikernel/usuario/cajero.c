@@ -0,0 +1,40 @@
+/*
+ * usuario/cajero.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que hace OPERACIONES operaciones sobre la cuenta
+ * "origen" de prueba_multiple tomando solo su mutex con lock. Se lanzan
+ * dos, de modo que mientras uno lo tiene el otro ya lo espera y el mutex
+ * no llega a quedar libre; aun asi, los transferidores que lo piden con
+ * lock_multiple deben conseguirlo en su turno y acabar antes que ellos.
+ */
+
+#include "servicios.h"
+
+#define OPERACIONES 40
+
+int main(){
+	int id, origen, i;
+
+	id=obtener_id_pr();
+	if ((origen=abrir_mutex("origen"))<0){
+		printf("cajero (%d): error abriendo mutex. NO DEBE APARECER\n", id);
+		return 1;
+	}
+
+	for (i=0; i<OPERACIONES; i++){
+		lock(origen);
+		/* la operacion dura un tick con la cuenta tomada */
+		dormir_ticks(1);
+		unlock(origen);
+	}
+	printf("cajero (%d): %d operaciones hechas en el tick %d\n", id, OPERACIONES, obtener_ticks());
+
+	return 0;
+}
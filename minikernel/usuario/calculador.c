@@ -0,0 +1,33 @@
+/*
+ * usuario/calculador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que gasta CPU sin bloquearse durante al menos
+ * VENTANA ticks de reloj, mas de lo que duerme en total prueba_prioridad,
+ * de modo que sigue en marcha cada vez que esta despierta. Solo consulta
+ * el reloj cada BLOQUE iteraciones.
+ */
+
+#include "servicios.h"
+
+#define VENTANA 400
+#define BLOQUE 1000000
+
+int main(){
+	int i, inicio, tot=0;
+	int j=5;
+
+	inicio=obtener_ticks();
+	do
+		for (i=0; i<BLOQUE; i++)
+			tot+=j*i;
+	while (obtener_ticks()-inicio < VENTANA);
+	printf("calculador (%d): termina en el tick %d con %d\n", obtener_id_pr(), obtener_ticks(), tot);
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * usuario/consumidor.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que hace de consumidor del buffer acotado de
+ * prueba_sem. Consume ELEMENTOS/2 elementos y devuelve los huecos en
+ * lotes de LOTE con una sola llamada a senalizar_sem. Se compila una vez
+ * por tamano de lote (consumidor1, consumidor8).
+ */
+
+#include "servicios.h"
+
+#ifndef LOTE
+#define LOTE 1
+#endif
+
+#define ELEMENTOS 20000	/* los que produce el productor, entre dos consumidores */
+#define REINTENTOS 100
+
+int main(){
+	int id, huecos, elementos, i, inicio, ticks;
+
+	id=obtener_id_pr();
+
+	/* espera a que el productor haya creado los semaforos */
+	for (i=0; (huecos=abrir_sem("huecos"))<0; i++){
+		if (i==REINTENTOS){
+			printf("consumidor (%d): no aparece el productor. NO DEBE APARECER\n", id);
+			return 1;
+		}
+		dormir_ticks(1);
+	}
+	if ((elementos=abrir_sem("llenos"))<0){
+		printf("consumidor (%d): error abriendo semaforos. NO DEBE APARECER\n", id);
+		return 1;
+	}
+
+	inicio=obtener_ticks();
+	for (i=1; i<=ELEMENTOS/2; i++){
+		esperar_sem(elementos);
+		if (i%LOTE==0)
+			senalizar_sem(huecos, LOTE);
+	}
+	if ((i-1)%LOTE)
+		senalizar_sem(huecos, (i-1)%LOTE);
+
+	ticks=obtener_ticks()-inicio;
+	printf("consumidor (%d): lotes de %d, %d elementos en %d ticks (%d por tick)\n",
+		id, LOTE, ELEMENTOS/2, ticks, ticks ? ELEMENTOS/2/ticks : ELEMENTOS/2);
+
+	cerrar_sem(huecos);
+	cerrar_sem(elementos);
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * usuario/convoy.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que alterna RONDAS veces una seccion critica con el
+ * mutex "convoy" de prueba_prorroga y trabajo fuera de ella, y muestra los
+ * ticks que ha esperado en total por el mutex.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 6
+#define SECCION 18000000	/* unos dos ticks */
+#define FUERA 60000000	/* casi una rodaja */
+
+static void gastar(int n){
+	int i;
+
+	for (i=0; i<n; i++)
+		;
+}
+
+int main(){
+	int convoy, hechos, i, antes, espera=0;
+
+	if ((convoy=abrir_mutex("convoy"))<0 || (hechos=abrir_sem("hechos"))<0){
+		printf("convoy: error abriendo objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	for (i=0; i<RONDAS; i++){
+		antes=obtener_ticks();
+		lock(convoy);
+		espera+=obtener_ticks()-antes;
+		gastar(SECCION);
+		unlock(convoy);
+		gastar(FUERA);
+	}
+	printf("convoy (%d): %d ticks esperando el mutex\n", obtener_id_pr(), espera);
+
+	senalizar_sem(hechos, 1);
+	return 0;
+}
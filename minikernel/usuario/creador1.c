@@ -1,9 +1,9 @@
 /*
  * usuario/creador1.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -37,6 +37,6 @@ int main(){
 
 	printf("creador1 termina\n");
 
-	/* cierre implcito de mutex */
+	/* cierre implícito de mutex */
 	return 0;
 }
@@ -1,9 +1,9 @@
 /*
  * usuario/creador3.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -34,7 +34,7 @@ int main(){
 
 	printf("creador3 termina\n");
 
-        /* cierre implcito de mutex */
+        /* cierre implícito de mutex */
 
 	return 0;
 }
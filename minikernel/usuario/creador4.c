@@ -1,9 +1,9 @@
 /*
  * usuario/creador4.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -34,7 +34,7 @@ int main(){
 
 	printf("creador4 termina\n");
 
-        /* cierre implcito de mutex */
+        /* cierre implícito de mutex */
 
 	return 0;
 }
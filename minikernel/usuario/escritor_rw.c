@@ -0,0 +1,45 @@
+/*
+ * usuario/escritor_rw.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que escribe repetidamente bajo el cerrojo "conf" de
+ * prueba_rwlock, menos a menudo de lo que leen los lector_rw.
+ */
+
+#include "servicios.h"
+
+#define ESCRITURAS 5
+
+static void escribir_bajo(int rw){
+	int i;
+
+	for (i=0; i<ESCRITURAS; i++){
+		lock_escritor(rw);
+		dormir_ticks(2);
+		unlock_rwlock(rw);
+		dormir_ticks(4);
+	}
+	/* fuera del cerrojo no se puede salir de el */
+	if (unlock_rwlock(rw)==0)
+		printf("escritor_rw: unlock sin estar dentro aceptado. NO DEBE APARECER\n");
+}
+
+int main(){
+	int rw, hechos;
+
+	if ((rw=abrir_rwlock("conf"))<0 || (hechos=abrir_sem("hechos"))<0){
+		printf("escritor_rw: error abriendo objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	escribir_bajo(rw);
+
+	senalizar_sem(hechos, 1);
+	return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * usuario/esperador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que espera en la variable condicion "aviso" de
+ * prueba_cond con el mutex "cerrojo" y, al volver de cond_wait ya con el
+ * mutex, comprueba que nadie mas lo tiene durante un rato antes de
+ * soltarlo.
+ */
+
+#include "servicios.h"
+
+int main(){
+	int id, cerrojo, aviso, listos, hechos, i;
+
+	id=obtener_id_pr();
+	if ((cerrojo=abrir_mutex("cerrojo"))<0 || (aviso=abrir_cond("aviso"))<0 ||
+	    (listos=abrir_sem("listos"))<0 || (hechos=abrir_sem("hechos"))<0){
+		printf("esperador (%d): error abriendo objetos. NO DEBE APARECER\n", id);
+		return 1;
+	}
+
+	lock(cerrojo);
+	senalizar_sem(listos, 1);
+	cond_wait(aviso, cerrojo);
+
+	printf("esperador (%d): avisado, tiene el mutex\n", id);
+	/* con el mutex tomado un lock propio es un interbloqueo */
+	for (i=0; i<200000; i++)
+		;
+	if (lock(cerrojo)==0)
+		printf("esperador (%d): lock propio aceptado. NO DEBE APARECER\n", id);
+	printf("esperador (%d): suelta el mutex\n", id);
+	unlock(cerrojo);
+
+	senalizar_sem(hechos, 1);
+	return 0;
+}
@@ -1,20 +1,20 @@
 /*
  * usuario/excep_arit.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
 /*
- * Programa de usuario que fuerza una excepcin aritmtica
+ * Programa de usuario que fuerza una excepción aritmética
  */
 
 #include "servicios.h"
 
-#define TOT_ITER 200	/* nmero total de iteraciones */
-#define ITER_EXCEP 22	/* iteracin en la que causa excepcin */
+#define TOT_ITER 200	/* número total de iteraciones */
+#define ITER_EXCEP 22	/* iteración en la que causa excepción */
 
 int tot=0;
 
@@ -25,11 +25,11 @@ int main(){
 	for (i=0; i<TOT_ITER; i++){
 		printf("excep_arit: i %d \n", i);
 
-		/* Forzando una excepcin */
+		/* Forzando una excepción */
 		if ((i+1)%ITER_EXCEP==0)
 			i/=tot;
 	}
-	/* No debera llegar ya que ha generado una excepcin */
+	/* No debería llegar ya que ha generado una excepción */
 	printf("excep_arit: termina\n");
 	return 0;
 }
@@ -1,21 +1,21 @@
 /*
  * usuario/excep_mem.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
 /*
- * Programa de usuario que fuerza una excepcin en acceso a memoria.
- * Adems crea un proceso hijo (simplon).
+ * Programa de usuario que fuerza una excepción en acceso a memoria.
+ * Además crea un proceso hijo (simplon).
  */
 
 #include "servicios.h"
 
-#define TOT_ITER 200	/* Nmero total de iteraciones */
-#define ITER_EXCEP 20	/* iteracin en la que causa excepcin */
+#define TOT_ITER 200	/* Número total de iteraciones */
+#define ITER_EXCEP 20	/* iteración en la que causa excepción */
 
 int main(){
 	int i;
@@ -31,6 +31,6 @@ int main(){
 	}
 	printf("excep_mem: termina\n");
 	terminar_proceso();
-	return 0; /* No se debera llegar a este punto */
+	return 0; /* No se debería llegar a este punto */
 }
 
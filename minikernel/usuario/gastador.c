@@ -0,0 +1,46 @@
+/*
+ * usuario/gastador.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que gasta CPU durante VENTANA ticks de reloj con
+ * TICKETS tickets y muestra la parte de esos ticks en la que ha estado
+ * en ejecucion, junto a la que le corresponde por sus tickets. Se
+ * compila una vez por cada numero de tickets (gastador3, gastador1).
+ */
+
+#include "servicios.h"
+
+#ifndef TICKETS
+#define TICKETS 1
+#endif
+
+#define TOTAL_TICKETS 4	/* suma de los tickets de los gastadores de prueba_stride */
+#define VENTANA 500	/* ticks de reloj que dura la medida */
+
+int main(){
+	struct tiempo_ejecucion t;
+	int id, inicio, ahora, propios, total;
+
+	id=obtener_id_pr();
+	if (fijar_tickets(TICKETS)<0)
+		printf("gastador (%d): error fijando tickets\n", id);
+
+	inicio=tiempos_proceso(&t);
+	propios=t.usuario+t.sistema;
+	do
+		ahora=tiempos_proceso(&t);
+	while (ahora-inicio < VENTANA);
+
+	propios=t.usuario+t.sistema-propios;
+	total=ahora-inicio;
+	printf("gastador (%d): %d tickets, %d de %d ticks (%d%%), esperado %d%%\n",
+		id, TICKETS, propios, total, propios*100/total,
+		TICKETS*100/TOTAL_TICKETS);
+	return 0;
+}
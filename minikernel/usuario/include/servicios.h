@@ -1,9 +1,9 @@
 /*
  *  usuario/include/servicios.h
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
  */
@@ -20,32 +20,166 @@
 #ifndef SERVICIOS_H
 #define SERVICIOS_H
 
-/* Evita el uso del printf de la bilioteca estndar */
+/* Evita el uso del printf de la bilioteca estándar */
 #define printf escribirf
 
 //Objetivo parcial 3, definir el tipo de mutex
 #define NO_RECURSIVO 0
 #define RECURSIVO 1
 
+//Politica de los cerrojos de lectores/escritores
+#define PREFIERE_LECTORES 0
+#define PREFIERE_ESCRITORES 1
+
+//Valor que devuelve esperar_barrera al ultimo en llegar
+#define BARRERA_ULTIMO 1
+
+//Modos de leer: crudo, con lo que haya, o canonico, por lineas completas
+#define LEER_CRUDO 0
+#define LEER_CANONICO 1
+
+//Niveles de los mensajes del nucleo
+#define LOG_ERROR 0
+#define LOG_AVISO 1
+#define LOG_INFO 2
+#define LOG_DEPURACION 3
+#define LOG_TRAZA 4
+
+/* Ticks en los que el proceso estaba en modo usuario y en modo sistema */
+struct tiempo_ejecucion {
+	int usuario;
+	int sistema;
+};
+
+/* Busquedas hechas en el espacio de nombres y entradas comparadas en ellas */
+struct coste_nombres {
+	int busquedas;
+	int comparaciones;
+};
+
+/* Accesos de cada tipo que han esperado en un cerrojo de lectores/escritores
+   y ticks esperados en total */
+struct esperas_rwlock {
+	int esperas_lectores;
+	int ticks_lectores;
+	int esperas_escritores;
+	int ticks_escritores;
+};
+
+/* Prorrogas de rodaja concedidas, ticks que han durado en total y las que se
+   han dejado antes de agotarlas */
+struct prorrogas {
+	int concedidas;
+	int ticks;
+	int cedidas;
+};
+
+/* Modos de la salida de escribir y printf: se vacia al completar cada
+   linea o solo al llenarse el buffer */
+#define SALIDA_LINEA 0
+#define SALIDA_COMPLETA 1
+
+/* Trozo de texto de escribirv, que escribe hasta MAX_VECTOR_ES juntos */
+#define MAX_VECTOR_ES 16
+struct vector_es {
+	char *texto;
+	unsigned int longi;
+};
+
 /* Funcion de biblioteca */
 int escribirf(const char *formato, ...);
+//Salida con buffer: modo (devuelve el anterior), vaciado explicito y
+//llamadas al sistema que ha hecho
+int modo_salida(int modo);
+int vaciar_salida();
+int llamadas_salida();
 
 /* Llamadas al sistema proporcionadas */
 int crear_proceso(char *prog);
 int terminar_proceso();
 int escribir(char *texto, unsigned int longi);
+int escribirv(struct vector_es *vector, unsigned int n);
 //Objetivo parcial 1
 int obtener_id_pr(); //prototipo funcion de interfaz
 //Objetivo  parcial 2
 int dormir(unsigned int segundos);
+//Dormir con resolucion de tick, relativo o hasta un tick absoluto
+int dormir_ticks(unsigned int ticks);
+int dormir_hasta(unsigned int tick);
+int obtener_ticks();
+//Holgura de temporizacion (en ticks) y despertares ahorrados al agrupar
+int fijar_holgura(unsigned int ticks);
+int despertares_ahorrados();
 //Objetivo parcial 3, interfaz de los servicios de mutex
 int crear_mutex(char *nombre, int tipo);
 int abrir_mutex(char *nombre);
 int lock(unsigned int mutexid);
 int unlock(unsigned int mutexid);
 int cerrar_mutex(unsigned int mutexid);
+//Toman y sueltan juntos hasta 8 mutex, sin tomar ninguno si no estan todos
+int lock_multiple(unsigned int mutexids[], int n);
+int unlock_multiple(unsigned int mutexids[], int n);
+//Variantes que no esperan o que esperan como mucho un plazo en ticks;
+//devuelven -1 si no lo consiguen
+int trylock(unsigned int mutexid);
+int lock_timeout(unsigned int mutexid, unsigned int ticks);
+int intentar_crear_mutex(char *nombre, int tipo);
+//Coste del espacio de nombres; devuelve los nombres registrados
+int coste_nombres(struct coste_nombres *coste);
+//Semaforos contadores con nombre
+int crear_sem(char *nombre, int valor);
+int abrir_sem(char *nombre);
+int esperar_sem(unsigned int semid);
+int senalizar_sem(unsigned int semid, int n);
+int cerrar_sem(unsigned int semid);
+//Variables condicion con nombre, se esperan junto a un mutex
+int crear_cond(char *nombre);
+int abrir_cond(char *nombre);
+int cond_wait(unsigned int condid, unsigned int mutexid);
+int cond_signal(unsigned int condid);
+int cond_broadcast(unsigned int condid);
+int cerrar_cond(unsigned int condid);
+//Cerrojos de lectores/escritores con nombre
+int crear_rwlock(char *nombre, int politica);
+int abrir_rwlock(char *nombre);
+int lock_lector(unsigned int rwid);
+int lock_escritor(unsigned int rwid);
+int unlock_rwlock(unsigned int rwid);
+int cerrar_rwlock(unsigned int rwid);
+int esperas_rwlock(unsigned int rwid, struct esperas_rwlock *esperas);
+//Barreras con nombre para n procesos
+int crear_barrera(char *nombre, int n);
+int abrir_barrera(char *nombre);
+int esperar_barrera(unsigned int barreraid);
+int cerrar_barrera(unsigned int barreraid);
 //Objetivo parcial 5
 int leer_caracter();
+int leer_caracter_timeout(unsigned int ticks);
+int caracteres_perdidos();
+int leer(char *buf, unsigned int n, int modo);
+//Dispositivos de caracteres: "terminal", "nulo", "cero" y "eco"
+int abrir_dispositivo(char *nombre);
+int leer_dispositivo(unsigned int dispid, char *buf, unsigned int n);
+int escribir_dispositivo(unsigned int dispid, char *buf, unsigned int n);
+int sondear_dispositivo(unsigned int dispid);
+int cerrar_dispositivo(unsigned int dispid);
+//Lee lo que aun no haya leido del registro de la consola del nucleo
+int leer_log(char *buf, unsigned int n);
+//Nivel maximo de los mensajes del nucleo que se muestran; devuelve el anterior
+int fijar_umbral_log(int nivel);
+//Prioridades
+int fijar_prioridad(int prioridad);
+int herencias_prioridad();
+//Aplaza la expulsion al acabar la rodaja (activar!=0) para una seccion
+//critica de usuario, y prorrogas de rodaja concedidas
+int aplazar_expulsion(int activar);
+int prorrogas(struct prorrogas *p);
+//Tiempos de ejecucion y tickets de stride
+int tiempos_proceso(struct tiempo_ejecucion *t_ejec);
+int fijar_tickets(int tickets);
+//Clase de tiempo real EDF (tiempos en ticks)
+int fijar_edf(int periodo, int presupuesto, int plazo);
+int fallos_plazo();
 
 #endif /* SERVICIOS_H */
 
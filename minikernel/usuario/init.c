@@ -1,22 +1,22 @@
 /*
  * usuario/init.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
-/* Programa inicial que arranca el S.O. Slo se ejecutarn los programas
-   que se incluyan aqu, que, evidentemente, pueden ejecutar otros
+/* Programa inicial que arranca el S.O. Sólo se ejecutarán los programas
+   que se incluyan aquí, que, evidentemente, pueden ejecutar otros
    programas...
 */
 
 /*
  *
- * Contiene las mismas pruebas que se realizan para evaluar la prctica.
+ * Contiene las mismas pruebas que se realizan para evaluar la práctica.
  * Para llevar a cabo cada prueba, comente y descomente
- * las lneas correspondientes. En la versin inicial, la parte descomentada
+ * las líneas correspondientes. En la versión inicial, la parte descomentada
  * se corresponde con funcionalidad ya implementada en el material de apoyo.
  *
  */
@@ -0,0 +1,35 @@
+/*
+ * usuario/inquieto.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que duerme NUM_SIESTAS veces un periodo de unos
+ * pocos ticks que depende de su identificador, con HOLGURA ticks de
+ * holgura, y muestra los despertares ahorrados en el sistema.
+ */
+
+#include "servicios.h"
+
+#define HOLGURA 8
+#define NUM_SIESTAS 20
+
+int main(){
+	int id, i, inicio;
+
+	id=obtener_id_pr();
+	fijar_holgura(HOLGURA);
+
+	inicio=obtener_ticks();
+	for (i=0; i<NUM_SIESTAS; i++)
+		dormir_ticks(5+id%4);
+
+	printf("inquieto (%d): %d siestas de %d ticks en %d ticks, %d despertares ahorrados\n",
+		id, NUM_SIESTAS, 5+id%4, obtener_ticks()-inicio,
+		despertares_ahorrados());
+	return 0;
+}
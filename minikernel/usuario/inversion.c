@@ -0,0 +1,62 @@
+/*
+ * usuario/inversion.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que forma parte de la prueba de herencia de
+ * prioridad. Con prioridad PRIORIDAD espera RETARDO ticks y gasta CPU
+ * durante TRABAJO ticks, con el mutex "inv" tomado si USA_MUTEX. Se
+ * compila una vez por papel (inversion_baja, inversion_media,
+ * inversion_alta); la baja es la que crea el mutex.
+ */
+
+#include "servicios.h"
+
+#ifndef PRIORIDAD
+#define PRIORIDAD 1
+#define RETARDO 0
+#define TRABAJO 30
+#define USA_MUTEX 1
+#endif
+
+/* Gasta CPU durante ticks ticks de reloj */
+static void trabajar(int ticks){
+	int inicio=obtener_ticks();
+
+	while (obtener_ticks()-inicio < ticks);
+}
+
+int main(){
+	int id, desc=-1, inicio, espera=0;
+
+	id=obtener_id_pr();
+	fijar_prioridad(PRIORIDAD);
+	if (RETARDO>0)
+		dormir_ticks(RETARDO);
+
+	if (USA_MUTEX){
+		if (RETARDO==0)
+			desc=crear_mutex("inv", NO_RECURSIVO);
+		else
+			desc=abrir_mutex("inv");
+		if (desc<0)
+			printf("inversion (%d): error con el mutex. NO DEBE APARECER\n", id);
+		inicio=obtener_ticks();
+		lock(desc);
+		espera=obtener_ticks()-inicio;
+	}
+
+	trabajar(TRABAJO);
+
+	if (USA_MUTEX)
+		unlock(desc);
+
+	printf("inversion (%d): prioridad %d, %d ticks esperando el mutex, termina en el tick %d (%d herencias)\n",
+		id, PRIORIDAD, espera, obtener_ticks(), herencias_prioridad());
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * usuario/lector_rw.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que lee repetidamente bajo el cerrojo "conf" de
+ * prueba_rwlock, saliendo de el entre lectura y lectura. Cada lector
+ * empieza con un desfase distinto para que casi siempre haya alguno
+ * dentro.
+ */
+
+#include "servicios.h"
+
+#define LECTURAS 20
+
+static void leer_bajo(int rw){
+	int i;
+
+	for (i=0; i<LECTURAS; i++){
+		lock_lector(rw);
+		/* la lectura dura unos ticks, asi se solapan */
+		dormir_ticks(3);
+		/* un lector dentro no puede entrar a escribir */
+		if (lock_escritor(rw)==0)
+			printf("lector_rw: escritura aceptada. NO DEBE APARECER\n");
+		unlock_rwlock(rw);
+		dormir_ticks(1);
+	}
+}
+
+int main(){
+	int rw, hechos;
+
+	if ((rw=abrir_rwlock("conf"))<0 || (hechos=abrir_sem("hechos"))<0){
+		printf("lector_rw: error abriendo objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	dormir_ticks(obtener_id_pr()%4);
+	leer_bajo(rw);
+
+	senalizar_sem(hechos, 1);
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ *  usuario/lib/salida.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ */
+
+/*
+ *
+ * Salida con buffer de los programas de usuario. escribir, y con ella
+ * escribirf, deja el texto en un buffer del proceso, que se vacia con una
+ * sola llamada escribirv junto con lo que no quepa. En modo SALIDA_LINEA,
+ * el de defecto, se vacia ademas al completar cada linea; en modo
+ * SALIDA_COMPLETA solo al llenarse, con vaciar_salida y al terminar el
+ * proceso con terminar_proceso. Lo que tenga en el buffer un proceso que
+ * muere por una excepcion se pierde.
+ *
+ * Los procesos que ejecutan el mismo programa comparten sus variables
+ * globales, asi que cada uno tiene su buffer en la posicion de su
+ * identificador y se le reconoce por la direccion de su pila: se guarda
+ * la parte de la pila que se le ha visto usar y solo cuando la pila sale
+ * de las partes conocidas se pregunta al nucleo el identificador. Como un
+ * proceso nuevo puede tener la pila donde la tenia uno que murio por una
+ * excepcion, al vaciar el buffer se pasa al nucleo el identificador del
+ * propietario y la misma llamada escribirv comprueba que es el actual.
+ *
+ */
+
+#include "const.h"
+#include "servicios.h"
+
+/* Funcion del modulo "serv": escribirv que solo escribe si el proceso
+   actual es el propietario dado */
+int escribirv_de(struct vector_es *vector, unsigned int n, int propietario);
+
+#define TAM_SALIDA 4096
+
+typedef struct {
+	int usada;
+	//Identificador del proceso propietario
+	int id;
+	//Parte conocida de la pila del proceso
+	char *pila_min;
+	char *pila_max;
+	int modo;
+	//Llamadas al sistema hechas para vaciar el buffer
+	int llamadas;
+	unsigned int n;
+	char buf[TAM_SALIDA];
+} salida_proceso;
+
+static salida_proceso salidas[MAX_PROC];
+
+//Busca el buffer del proceso actual, y lo prepara si aun no tiene
+static salida_proceso * salida_actual(){
+	char marca;	/* su direccion esta en la pila del proceso actual */
+	char *pila=&marca;
+	salida_proceso *s;
+	int id;
+
+	for (s=salidas; s<salidas+MAX_PROC; s++)
+		if (s->usada && pila>=s->pila_min && pila<=s->pila_max)
+			return s;
+
+	id=obtener_id_pr();
+	if (id<0 || id>=MAX_PROC)
+		return NULL;
+	s=&salidas[id];
+	//Se amplia la parte conocida mientras no pase de TAM_PILA; si pasaria,
+	//es de un proceso anterior con el mismo identificador que no llego a
+	//terminar_proceso
+	if (s->usada && pila>=s->pila_max-TAM_PILA && pila<=s->pila_min+TAM_PILA){
+		if (pila<s->pila_min)
+			s->pila_min=pila;
+		else
+			s->pila_max=pila;
+		return s;
+	}
+	//Mientras se prepara no esta usada y nadie la confunde con la suya
+	s->usada=0;
+	s->id=id;
+	s->pila_min=s->pila_max=pila;
+	s->modo=SALIDA_LINEA;
+	s->llamadas=0;
+	s->n=0;
+	s->usada=1;
+	return s;
+}
+
+//Escribe lo que haya en el buffer seguido de los longi bytes de texto con
+//una sola llamada, y deja el buffer vacio. Si el buffer resulta ser de
+//otro proceso se libera sin escribirlo y el texto va al del actual
+static void volcar(salida_proceso *s, char *texto, unsigned int longi){
+	struct vector_es v[2];
+	int n=0;
+
+	if (s->n>0){
+		v[n].texto=s->buf;
+		v[n].longi=s->n;
+		n++;
+	}
+	if (longi>0){
+		v[n].texto=texto;
+		v[n].longi=longi;
+		n++;
+	}
+	if (n==0)
+		return;
+	s->n=0;
+	s->llamadas++;
+	if (escribirv_de(v, n, s->id)>=0)
+		return;
+	s->usada=0;
+	if ((s=salida_actual())!=NULL)
+		volcar(s, texto, longi);
+	else if (longi>0){
+		v[0].texto=texto;
+		v[0].longi=longi;
+		escribirv(v, 1);
+	}
+}
+
+//Guarda el texto en el buffer si cabe y si no lo escribe junto con el buffer
+static void guardar(salida_proceso *s, char *texto, unsigned int longi){
+	unsigned int i;
+
+	if (s->n+longi > TAM_SALIDA){
+		volcar(s, texto, longi);
+		return;
+	}
+	for (i=0; i<longi; i++)
+		s->buf[s->n++]=texto[i];
+}
+
+int escribir(char *texto, unsigned int longi){
+	salida_proceso *s;
+	unsigned int hasta;
+
+	if ((s=salida_actual())==NULL){
+		struct vector_es v={texto, longi};
+		return escribirv(&v, 1)<0 ? -1 : 0;
+	}
+	//En modo linea se escribe ya hasta el ultimo fin de linea
+	if (s->modo==SALIDA_LINEA){
+		for (hasta=longi; hasta>0 && texto[hasta-1]!='\n'; hasta--)
+			;
+		if (hasta>0){
+			guardar(s, texto, hasta);
+			volcar(s, NULL, 0);
+			texto+=hasta;
+			longi-=hasta;
+		}
+	}
+	guardar(s, texto, longi);
+	return 0;
+}
+
+//Fija el modo de la salida del proceso y devuelve el anterior
+int modo_salida(int modo){
+	salida_proceso *s;
+	int anterior;
+
+	if ((modo!=SALIDA_LINEA && modo!=SALIDA_COMPLETA) || (s=salida_actual())==NULL)
+		return -1;
+	anterior=s->modo;
+	s->modo=modo;
+	return anterior;
+}
+
+int vaciar_salida(){
+	salida_proceso *s;
+
+	if ((s=salida_actual())==NULL)
+		return -1;
+	volcar(s, NULL, 0);
+	return 0;
+}
+
+//Llamadas al sistema que ha hecho el proceso para vaciar su buffer
+int llamadas_salida(){
+	salida_proceso *s;
+
+	if ((s=salida_actual())==NULL)
+		return -1;
+	return s->llamadas;
+}
+
+//Vacia el buffer del proceso que termina y lo deja libre
+void terminar_salida(){
+	salida_proceso *s;
+
+	if ((s=salida_actual())==NULL)
+		return;
+	volcar(s, NULL, 0);
+	s->usada=0;
+}
@@ -1,9 +1,9 @@
 /*
  *  usuario/lib/serv.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  * 
  *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
  */
@@ -20,13 +20,17 @@
 #include "llamsis.h"
 #include "servicios.h"
 
-/* Funcin del mdulo "misc" que prepara el cdigo de la llamada
-   (en el registro 0), los parmetros (en registros 1, 2, ...), realiza la
+/* Función del módulo "misc" que prepara el código de la llamada
+   (en el registro 0), los parámetros (en registros 1, 2, ...), realiza la
    instruccion de llamada al sistema  y devuelve el resultado 
    (que obtiene del registro 0) */
 
 int llamsis(int llamada, int nargs, ... /* args */);
 
+/* Función del módulo "salida" que vacia el buffer de salida del proceso y
+   lo libera */
+void terminar_salida();
+
 
 /*
  *
@@ -39,10 +43,16 @@ int crear_proceso(char *prog){
 	return llamsis(CREAR_PROCESO, 1, (long)prog);
 }
 int terminar_proceso(){
+	terminar_salida();
 	return llamsis(TERMINAR_PROCESO, 0);
 }
-int escribir(char *texto, unsigned int longi){
-	return llamsis(ESCRIBIR, 2, (long)texto, (long)longi);
+//escribir, con buffer, esta en el modulo salida
+int escribirv(struct vector_es *vector, unsigned int n){
+	return llamsis(ESCRIBIRV, 3, (long)vector, (long)n, -1L);
+}
+//Para el modulo "salida": no escribe nada si el buffer no es del proceso
+int escribirv_de(struct vector_es *vector, unsigned int n, int propietario){
+	return llamsis(ESCRIBIRV, 3, (long)vector, (long)n, (long)propietario);
 }
 
 //Objetivo parcial 1, proporciona interfaz a nuevo servicio
@@ -54,6 +64,24 @@ int obtener_id_pr(){
 int dormir(unsigned int segundos){ 
         return llamsis(DORMIR, 1, (long)segundos);
 }
+int dormir_ticks(unsigned int ticks){ 
+        return llamsis(DORMIR_TICKS, 1, (long)ticks);
+}
+//Duerme hasta el tick absoluto indicado (ver obtener_ticks)
+int dormir_hasta(unsigned int tick){ 
+        return llamsis(DORMIR_HASTA, 1, (long)tick);
+}
+int obtener_ticks(){
+        return llamsis(OBTENER_TICKS, 0);
+}
+//Fija cuantos ticks puede retrasarse el despertar del proceso para
+//agruparlo con otros y devuelve la holgura anterior
+int fijar_holgura(unsigned int ticks){
+        return llamsis(FIJAR_HOLGURA, 1, (long)ticks);
+}
+int despertares_ahorrados(){
+        return llamsis(DESPERTARES_AHORRADOS, 0);
+}
 
 /*Objetivo parcial 3, crear un proceso y obtiene descriptor que permite acceder al mismo*/
 int crear_mutex(char *nombre, int tipo){
@@ -73,8 +101,185 @@ int unlock(unsigned int mutexid){
 int cerrar_mutex(unsigned int mutexid){
         return llamsis(CERRAR_MUTEX, 1, (long)mutexid);
 }
+//Toma todos los mutex del conjunto en una sola llamada, o espera sin
+//tomar ninguno hasta que esten todos libres
+int lock_multiple(unsigned int mutexids[], int n){
+        return llamsis(LOCK_MULTIPLE, 2, (long)mutexids, (long)n);
+}
+int unlock_multiple(unsigned int mutexids[], int n){
+        return llamsis(UNLOCK_MULTIPLE, 2, (long)mutexids, (long)n);
+}
+//Toma el mutex solo si esta libre
+int trylock(unsigned int mutexid){
+        return llamsis(TRYLOCK, 1, (long)mutexid);
+}
+//Toma el mutex esperando como mucho el plazo dado
+int lock_timeout(unsigned int mutexid, unsigned int ticks){
+        return llamsis(LOCK_TIMEOUT, 2, (long)mutexid, (long)ticks);
+}
+//Crea un mutex sin esperar si no queda ninguno libre
+int intentar_crear_mutex(char *nombre, int tipo){
+        return llamsis(INTENTAR_CREAR_MUTEX, 2, (long)nombre, (long)tipo);
+}
+//Rellena el coste de las busquedas por nombre y devuelve cuantos hay
+int coste_nombres(struct coste_nombres *coste){
+        return llamsis(COSTE_NOMBRES, 1, (long)coste);
+}
+
+//Semaforos contadores, crea uno con el valor inicial dado
+int crear_sem(char *nombre, int valor){
+        return llamsis(CREAR_SEM, 2, (long)nombre, (long)valor);
+}
+int abrir_sem(char *nombre){
+        return llamsis(ABRIR_SEM, 1, (long)nombre);
+}
+int esperar_sem(unsigned int semid){
+        return llamsis(ESPERAR_SEM, 1, (long)semid);
+}
+//Suma n unidades al semaforo, despertando hasta n procesos
+int senalizar_sem(unsigned int semid, int n){
+        return llamsis(SENALIZAR_SEM, 2, (long)semid, (long)n);
+}
+int cerrar_sem(unsigned int semid){
+        return llamsis(CERRAR_SEM, 1, (long)semid);
+}
+
+//Variables condicion
+int crear_cond(char *nombre){
+        return llamsis(CREAR_COND, 1, (long)nombre);
+}
+int abrir_cond(char *nombre){
+        return llamsis(ABRIR_COND, 1, (long)nombre);
+}
+//Suelta el mutex y espera un aviso; vuelve con el mutex otra vez tomado
+int cond_wait(unsigned int condid, unsigned int mutexid){
+        return llamsis(COND_WAIT, 2, (long)condid, (long)mutexid);
+}
+int cond_signal(unsigned int condid){
+        return llamsis(COND_SIGNAL, 1, (long)condid);
+}
+int cond_broadcast(unsigned int condid){
+        return llamsis(COND_BROADCAST, 1, (long)condid);
+}
+int cerrar_cond(unsigned int condid){
+        return llamsis(CERRAR_COND, 1, (long)condid);
+}
+
+//Cerrojos de lectores/escritores, la politica es PREFIERE_LECTORES o
+//PREFIERE_ESCRITORES
+int crear_rwlock(char *nombre, int politica){
+        return llamsis(CREAR_RWLOCK, 2, (long)nombre, (long)politica);
+}
+int abrir_rwlock(char *nombre){
+        return llamsis(ABRIR_RWLOCK, 1, (long)nombre);
+}
+int lock_lector(unsigned int rwid){
+        return llamsis(LOCK_LECTOR, 1, (long)rwid);
+}
+int lock_escritor(unsigned int rwid){
+        return llamsis(LOCK_ESCRITOR, 1, (long)rwid);
+}
+//Sale del cerrojo, tanto si se entro a leer como a escribir
+int unlock_rwlock(unsigned int rwid){
+        return llamsis(UNLOCK_RWLOCK, 1, (long)rwid);
+}
+int cerrar_rwlock(unsigned int rwid){
+        return llamsis(CERRAR_RWLOCK, 1, (long)rwid);
+}
+int esperas_rwlock(unsigned int rwid, struct esperas_rwlock *esperas){
+        return llamsis(ESPERAS_RWLOCK, 2, (long)rwid, (long)esperas);
+}
+
+//Barreras
+int crear_barrera(char *nombre, int n){
+        return llamsis(CREAR_BARRERA, 2, (long)nombre, (long)n);
+}
+int abrir_barrera(char *nombre){
+        return llamsis(ABRIR_BARRERA, 1, (long)nombre);
+}
+//Devuelve BARRERA_ULTIMO al ultimo en llegar y 0 a los demas
+int esperar_barrera(unsigned int barreraid){
+        return llamsis(ESPERAR_BARRERA, 1, (long)barreraid);
+}
+int cerrar_barrera(unsigned int barreraid){
+        return llamsis(CERRAR_BARRERA, 1, (long)barreraid);
+}
 
 //Objetivo parcial 5, interfaz de funcion leer caracter
 int leer_caracter(){
         return llamsis(LEER_CARACTER, 0);
+}
+//Lee un caracter esperando como mucho el plazo dado; -1 si no llega
+int leer_caracter_timeout(unsigned int ticks){
+        return llamsis(LEER_CARACTER_TIMEOUT, 1, (long)ticks);
+}
+//Caracteres del terminal perdidos por llegar con el buffer lleno
+int caracteres_perdidos(){
+        return llamsis(CARACTERES_PERDIDOS, 0);
+}
+//Lee hasta n caracteres: en modo crudo los que haya, al menos uno, y en
+//canonico hasta el fin de linea incluido
+int leer(char *buf, unsigned int n, int modo){
+        return llamsis(LEER, 3, (long)buf, (long)n, (long)modo);
+}
+
+//Dispositivos de caracteres
+int abrir_dispositivo(char *nombre){
+        return llamsis(ABRIR_DISPOSITIVO, 1, (long)nombre);
+}
+int leer_dispositivo(unsigned int dispid, char *buf, unsigned int n){
+        return llamsis(LEER_DISPOSITIVO, 3, (long)dispid, (long)buf, (long)n);
+}
+int escribir_dispositivo(unsigned int dispid, char *buf, unsigned int n){
+        return llamsis(ESCRIBIR_DISPOSITIVO, 3, (long)dispid, (long)buf, (long)n);
+}
+//Indica si se puede leer del dispositivo sin esperar
+int sondear_dispositivo(unsigned int dispid){
+        return llamsis(SONDEAR_DISPOSITIVO, 1, (long)dispid);
+}
+int cerrar_dispositivo(unsigned int dispid){
+        return llamsis(CERRAR_DISPOSITIVO, 1, (long)dispid);
+}
+
+//Registro de la consola del nucleo, sin esperar
+int leer_log(char *buf, unsigned int n){
+        return llamsis(LEER_LOG, 2, (long)buf, (long)n);
+}
+int fijar_umbral_log(int nivel){
+        return llamsis(FIJAR_UMBRAL_LOG, 1, (long)nivel);
+}
+
+//Prioridades, fija la prioridad del proceso y devuelve la anterior
+int fijar_prioridad(int prioridad){
+        return llamsis(FIJAR_PRIORIDAD, 1, (long)prioridad);
+}
+//Veces que un proceso ha heredado prioridad por tener un mutex que otro espera
+int herencias_prioridad(){
+        return llamsis(HERENCIAS_PRIORIDAD, 0);
+}
+//Pide que no se le expulse al acabar la rodaja hasta que lo desactive
+int aplazar_expulsion(int activar){
+        return llamsis(APLAZAR_EXPULSION, 1, (long)activar);
+}
+int prorrogas(struct prorrogas *p){
+        return llamsis(PRORROGAS, 1, (long)p);
+}
+
+//Rellena los ticks de usuario y sistema del proceso y devuelve los ticks
+//transcurridos desde el arranque
+int tiempos_proceso(struct tiempo_ejecucion *t_ejec){
+        return llamsis(TIEMPOS_PROCESO, 1, (long)t_ejec);
+}
+
+//Stride, fija los tickets del proceso y devuelve los anteriores
+int fijar_tickets(int tickets){
+        return llamsis(FIJAR_TICKETS, 1, (long)tickets);
+}
+
+//EDF, pasa el proceso a la clase EDF (periodo 0 lo devuelve a la normal)
+int fijar_edf(int periodo, int presupuesto, int plazo){
+        return llamsis(FIJAR_EDF, 3, (long)periodo, (long)presupuesto, (long)plazo);
+}
+int fallos_plazo(){
+        return llamsis(FALLOS_PLAZO, 0);
 }
\ No newline at end of file
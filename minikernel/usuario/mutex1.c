@@ -1,9 +1,9 @@
 /*
  * usuario/mutex1.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -25,14 +25,14 @@ int main(){
 	if (lock(desc)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
-	/* segundo lock sobre semforo recursivo -> correcto */
+	/* segundo lock sobre semáforo recursivo -> correcto */
 	if (lock(desc)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
-	printf("mutex1 duerme 2 segs.: no debe ejecutar ningn proceso, ya que prueba_mutex est dormido y mutex2 bloqueado en mutex m1\n");
+	printf("mutex1 duerme 2 segs.: no debe ejecutar ningún proceso, ya que prueba_mutex está dormido y mutex2 bloqueado en mutex m1\n");
 	dormir(2);
 
-	/* cierre de semforo: debe despertar a mutex2 */
+	/* cierre de semáforo: debe despertar a mutex2 */
 	if (cerrar_mutex(desc)<0)
 		printf("error al cerrar mutex. NO DEBE APARECER\n");
 
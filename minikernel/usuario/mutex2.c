@@ -1,9 +1,9 @@
 /*
  * usuario/mutex2.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -28,7 +28,7 @@ int main(){
 	if (lock(desc1)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
-	printf("mutex2 ha obtenido mutex m1, se bloquear a continuacin al intentar obtener m2\n");
+	printf("mutex2 ha obtenido mutex m1, se bloqueará a continuación al intentar obtener m2\n");
 
 	if (lock(desc2)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
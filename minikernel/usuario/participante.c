@@ -0,0 +1,35 @@
+/*
+ * usuario/participante.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que hace RONDAS rondas de la barrera "fase" de
+ * prueba_barrera y avisa por el semaforo "hechos" al terminar.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 500
+
+int main(){
+	int fase, hechos, i;
+
+	if ((fase=abrir_barrera("fase"))<0 || (hechos=abrir_sem("hechos"))<0){
+		printf("participante: error abriendo objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	for (i=0; i<RONDAS; i++)
+		esperar_barrera(fase);
+
+	/* se cierra antes de avisar para que prueba_barrera pueda volver a
+	   crear la barrera en cuanto reciba todos los avisos */
+	cerrar_barrera(fase);
+	senalizar_sem(hechos, 1);
+	return 0;
+}
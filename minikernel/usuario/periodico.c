@@ -0,0 +1,50 @@
+/*
+ * usuario/periodico.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que se declara tarea EDF con periodo PERIODO y
+ * presupuesto PRESUPUESTO (en ticks, plazo igual al periodo) y gasta CPU
+ * durante VENTANA ticks. Al agotar el presupuesto el nucleo lo retiene
+ * hasta el siguiente periodo, por lo que debe obtener PRESUPUESTO/PERIODO
+ * de la CPU. Se compila una vez por presupuesto (periodico3, periodico8).
+ */
+
+#include "servicios.h"
+
+#ifndef PRESUPUESTO
+#define PRESUPUESTO 3
+#endif
+
+#define PERIODO 10
+#define VENTANA 300	/* ticks de reloj que dura la medida */
+
+int main(){
+	struct tiempo_ejecucion t;
+	int id, inicio, ahora, propios, total;
+
+	id=obtener_id_pr();
+	if (fijar_edf(PERIODO, PRESUPUESTO, PERIODO)<0){
+		printf("periodico (%d): admision EDF rechazada (%d/%d)\n",
+			id, PRESUPUESTO, PERIODO);
+		return 0;
+	}
+
+	inicio=tiempos_proceso(&t);
+	propios=t.usuario+t.sistema;
+	do
+		ahora=tiempos_proceso(&t);
+	while (ahora-inicio < VENTANA);
+
+	propios=t.usuario+t.sistema-propios;
+	total=ahora-inicio;
+	printf("periodico (%d): %d de %d ticks (%d%%), esperado %d%%, %d plazos perdidos\n",
+		id, propios, total, propios*100/total,
+		PRESUPUESTO*100/PERIODO, fallos_plazo());
+	return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * usuario/productor.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que hace de productor del buffer acotado de
+ * prueba_sem. Crea los semaforos "huecos" (con TAM_BUFFER unidades) y
+ * "llenos" (vacio), y produce ELEMENTOS elementos esperando un hueco
+ * para cada uno.
+ */
+
+#include "servicios.h"
+
+#define TAM_BUFFER 16
+#define ELEMENTOS 20000
+
+int main(){
+	int huecos, elementos, i, inicio;
+
+	if ((huecos=crear_sem("huecos", TAM_BUFFER))<0 ||
+	    (elementos=crear_sem("llenos", 0))<0){
+		printf("productor: error creando semaforos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	inicio=obtener_ticks();
+	for (i=0; i<ELEMENTOS; i++){
+		esperar_sem(huecos);
+		senalizar_sem(elementos, 1);
+	}
+	printf("productor: %d elementos en %d ticks\n", ELEMENTOS, obtener_ticks()-inicio);
+
+	/* cierre implicito de los semaforos */
+	return 0;
+}
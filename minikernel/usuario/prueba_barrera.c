@@ -0,0 +1,70 @@
+/*
+ * usuario/prueba_barrera.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que mide lo que cuesta una ronda de barrera segun el
+ * numero de procesos. Para cada tamano crea la barrera "fase" para n
+ * procesos, lanza n-1 participante y hace RONDAS rondas con ellos,
+ * contando cuantas veces ha sido el ultimo en llegar. Llega hasta
+ * MAX_PROCESOS, que es lo que cabe en la tabla de procesos contando con
+ * el propio programa.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 500	/* las mismas que hace cada participante */
+#define MAX_PROCESOS 10	/* MAX_PROC del nucleo */
+#define US_POR_TICK 10000	/* con el TICK de 100 por segundo del nucleo */
+
+static void medir(int n, int hechos){
+	int fase, i, inicio, ticks, ultimo=0;
+
+	if ((fase=crear_barrera("fase", n))<0){
+		printf("prueba_barrera: error creando la barrera. NO DEBE APARECER\n");
+		return;
+	}
+	for (i=1; i<n; i++)
+		if (crear_proceso("participante")<0)
+			printf("Error creando participante\n");
+
+	/* la primera ronda solo espera a que esten todos */
+	esperar_barrera(fase);
+	inicio=obtener_ticks();
+	for (i=1; i<RONDAS; i++)
+		if (esperar_barrera(fase)==BARRERA_ULTIMO)
+			ultimo++;
+	ticks=obtener_ticks()-inicio;
+
+	for (i=1; i<n; i++)
+		esperar_sem(hechos);
+	cerrar_barrera(fase);
+
+	printf("prueba_barrera: %d procesos, %d rondas en %d ticks (%d us por ronda), ultimo %d veces\n",
+		n, RONDAS-1, ticks, ticks*US_POR_TICK/(RONDAS-1), ultimo);
+}
+
+int main(){
+	int hechos, n;
+
+	printf("prueba_barrera: comienza\n");
+
+	if ((hechos=crear_sem("hechos", 0))<0){
+		printf("prueba_barrera: error creando semaforo. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	/* con un solo proceso la barrera no espera nunca */
+	medir(1, hechos);
+	for (n=2; n<MAX_PROCESOS; n*=2)
+		medir(n, hechos);
+	medir(MAX_PROCESOS, hechos);
+
+	printf("prueba_barrera: termina\n");
+	return 0; 
+}
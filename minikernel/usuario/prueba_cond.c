@@ -0,0 +1,61 @@
+/*
+ * usuario/prueba_cond.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba las variables condicion. Crea el mutex
+ * "cerrojo", la variable condicion "aviso" y NUM_ESPERADORES procesos
+ * esperador que esperan en ella. Cuando todos esperan toma el mutex y los
+ * avisa a la vez: deben pasar a la cola del mutex sin despertar ("Proceso
+ * bloqueado por un Lock" no debe aparecer tras el aviso) e ir recibiendo
+ * el mutex de uno en uno cuando lo suelta.
+ */
+
+#include "servicios.h"
+
+#define NUM_ESPERADORES 4
+
+int main(){
+	int cerrojo, aviso, listos, hechos, i, inicio;
+
+	printf("prueba_cond: comienza\n");
+
+	if ((cerrojo=crear_mutex("cerrojo", NO_RECURSIVO))<0 ||
+	    (aviso=crear_cond("aviso"))<0 ||
+	    (listos=crear_sem("listos", 0))<0 ||
+	    (hechos=crear_sem("hechos", 0))<0){
+		printf("prueba_cond: error creando objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	for (i=0; i<NUM_ESPERADORES; i++)
+		if (crear_proceso("esperador")<0)
+			printf("Error creando esperador\n");
+
+	/* Cada esperador avisa por "listos" con el mutex tomado y solo lo
+	   suelta en cond_wait, asi que cuando se consigue el mutex tras los
+	   NUM_ESPERADORES avisos todos estan ya esperando en "aviso" */
+	for (i=0; i<NUM_ESPERADORES; i++)
+		esperar_sem(listos);
+	lock(cerrojo);
+	printf("prueba_cond: avisa a todos con el mutex tomado\n");
+	inicio=obtener_ticks();
+	cond_broadcast(aviso);
+	unlock(cerrojo);
+
+	for (i=0; i<NUM_ESPERADORES; i++)
+		esperar_sem(hechos);
+	printf("prueba_cond: %d esperadores atendidos en %d ticks\n",
+		NUM_ESPERADORES, obtener_ticks()-inicio);
+
+	/* sin esperadores un aviso no tiene efecto */
+	cond_signal(aviso);
+
+	printf("prueba_cond: termina\n");
+	return 0; 
+}
@@ -0,0 +1,80 @@
+/*
+ * usuario/prueba_dispositivos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los dispositivos de caracteres: comprueba
+ * lo que devuelven nulo, cero y eco y escribe en el terminal a traves del
+ * suyo. Despues mide el coste de las llamadas de E/S escribiendo VECES
+ * veces TAM bytes en nulo y pasandolos por eco, sin que intervenga la
+ * consola.
+ */
+
+#include "servicios.h"
+
+#define VECES 20000
+#define TAM 64
+
+static char buf[TAM+1];
+static char msj[]="prueba_dispositivos: escrito con el manejador del terminal\n";
+
+int main(){
+	int nulo, cero, eco, term, i, n, inicio;
+
+	printf("prueba_dispositivos: comienza\n");
+
+	if ((nulo=abrir_dispositivo("nulo"))<0 || (cero=abrir_dispositivo("cero"))<0 ||
+	    (eco=abrir_dispositivo("eco"))<0 || (term=abrir_dispositivo("terminal"))<0){
+		printf("prueba_dispositivos: error abriendo dispositivos. NO DEBE APARECER\n");
+		return 1;
+	}
+	if (abrir_dispositivo("disco")>=0)
+		printf("prueba_dispositivos: abre un dispositivo que no existe. NO DEBE APARECER\n");
+	if (lock(nulo)>=0)
+		printf("prueba_dispositivos: lock sobre un dispositivo. NO DEBE APARECER\n");
+
+	printf("prueba_dispositivos: nulo, leer da %d y escribir %d\n",
+		leer_dispositivo(nulo, buf, TAM), escribir_dispositivo(nulo, buf, TAM));
+
+	for (i=0; i<TAM; i++)
+		buf[i]='x';
+	n=leer_dispositivo(cero, buf, TAM);
+	for (i=0; i<TAM && buf[i]==0; i++)
+		;
+	printf("prueba_dispositivos: cero, %d leidos y %d a cero\n", n, i);
+
+	printf("prueba_dispositivos: eco, sondear vacio da %d\n", sondear_dispositivo(eco));
+	escribir_dispositivo(eco, "hola", 4);
+	printf("prueba_dispositivos: eco, sondear tras escribir da %d\n", sondear_dispositivo(eco));
+	n=leer_dispositivo(eco, buf, TAM);
+	buf[n]='\0';
+	printf("prueba_dispositivos: eco devuelve %d bytes \"%s\"\n", n, buf);
+
+	escribir_dispositivo(term, msj, sizeof(msj)-1);
+
+	inicio=obtener_ticks();
+	for (i=0; i<VECES; i++)
+		escribir_dispositivo(nulo, buf, TAM);
+	printf("prueba_dispositivos: %d escrituras en nulo en %d ticks\n",
+		VECES, obtener_ticks()-inicio);
+
+	inicio=obtener_ticks();
+	for (i=0; i<VECES; i++){
+		escribir_dispositivo(eco, buf, TAM);
+		leer_dispositivo(eco, buf, TAM);
+	}
+	printf("prueba_dispositivos: %d escrituras y lecturas en eco en %d ticks\n",
+		VECES, obtener_ticks()-inicio);
+
+	cerrar_dispositivo(eco);
+	if (leer_dispositivo(eco, buf, TAM)>=0)
+		printf("prueba_dispositivos: lee de un dispositivo cerrado. NO DEBE APARECER\n");
+
+	printf("prueba_dispositivos: termina\n");
+	return 0;
+}
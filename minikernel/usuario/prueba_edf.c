@@ -0,0 +1,47 @@
+/*
+ * usuario/prueba_edf.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la clase de tiempo real EDF. Arranca
+ * un gastador normal y dos tareas periodicas: periodico3 pide el 30% de
+ * la CPU y debe obtenerlo sin perder plazos a pesar del gastador;
+ * periodico8 pide el 80% y debe ser rechazada por el control de admision.
+ * Antes comprueba que se rechaza un periodo fuera de rango y que con
+ * presupuestos grandes la utilizacion se calcula sin desbordarse.
+ */
+
+#include "servicios.h"
+
+#define PERIODO_GRANDE 400000	/* presupuesto*10000 no cabe en un int */
+
+int main(){
+
+	printf("prueba_edf: comienza\n");
+
+	if (fijar_edf(2000000000, 1, 2000000000)==0)
+		printf("prueba_edf: admitido periodo fuera de rango. NO DEBE APARECER\n");
+	/* al 100% ocupa toda la CPU; se sale enseguida */
+	if (fijar_edf(PERIODO_GRANDE, PERIODO_GRANDE, PERIODO_GRANDE)<0)
+		printf("prueba_edf: rechazado periodo grande al 100%%. NO DEBE APARECER\n");
+	else if (fijar_edf(PERIODO_GRANDE, PERIODO_GRANDE/2+1, PERIODO_GRANDE)<0 ||
+	    fijar_edf(0, 0, 0)<0)
+		printf("prueba_edf: error cambiando parametros EDF. NO DEBE APARECER\n");
+
+	if (crear_proceso("periodico3")<0)
+		printf("Error creando periodico3\n");
+
+	if (crear_proceso("periodico8")<0)
+		printf("Error creando periodico8\n");
+
+	if (crear_proceso("gastador1")<0)
+		printf("Error creando gastador1\n");
+
+	printf("prueba_edf: termina\n");
+	return 0; 
+}
@@ -0,0 +1,36 @@
+/*
+ * usuario/prueba_herencia.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la herencia de prioridad en los mutex
+ * con el caso clasico de inversion de prioridad. inversion_baja toma un
+ * mutex y trabaja con el; inversion_alta lo pide poco despues e
+ * inversion_media se pone a gastar CPU sin usar el mutex. Con herencia,
+ * inversion_baja pasa a la prioridad de inversion_alta, termina antes que
+ * inversion_media y inversion_alta solo espera lo que le falta a la baja.
+ */
+
+#include "servicios.h"
+
+int main(){
+
+	printf("prueba_herencia: comienza\n");
+
+	if (crear_proceso("inversion_baja")<0)
+		printf("Error creando inversion_baja\n");
+
+	if (crear_proceso("inversion_alta")<0)
+		printf("Error creando inversion_alta\n");
+
+	if (crear_proceso("inversion_media")<0)
+		printf("Error creando inversion_media\n");
+
+	printf("prueba_herencia: termina\n");
+	return 0; 
+}
@@ -0,0 +1,32 @@
+/*
+ * usuario/prueba_holgura.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la holgura de temporizacion. Arranca
+ * varios procesos inquieto que duermen periodos parecidos pero distintos
+ * con holgura; cada uno muestra cuantos despertares se han ahorrado en
+ * el sistema al agruparlos.
+ */
+
+#include "servicios.h"
+
+#define NUM_INQUIETOS 4
+
+int main(){
+	int i;
+
+	printf("prueba_holgura: comienza\n");
+
+	for (i=0; i<NUM_INQUIETOS; i++)
+		if (crear_proceso("inquieto")<0)
+			printf("Error creando inquieto\n");
+
+	printf("prueba_holgura: termina\n");
+	return 0; 
+}
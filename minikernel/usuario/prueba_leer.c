@@ -0,0 +1,61 @@
+/*
+ * usuario/prueba_leer.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que lee del teclado con leer en lugar de caracter a
+ * caracter. Primero lee LINEAS lineas en modo canonico, en el que se puede
+ * borrar el ultimo caracter con DEL o retroceso y toda la linea con ^U, y
+ * despues duerme ESPERA segundos y lee en modo crudo lo que se haya
+ * tecleado o pegado. Muestra cuantos caracteres ha leido por llamada; con
+ * leer_caracter seria uno.
+ */
+
+#include "servicios.h"
+
+#define LINEAS 3
+#define ESPERA 2
+#define TAM_LINEA 100
+
+int main(){
+	char buf[TAM_LINEA+1];
+	int id, i, n, fin, llamadas, total;
+
+	id=obtener_id_pr();
+	printf("prueba_leer (%d): comienza\n", id);
+
+	/* descarta lo que haya llegado antes de empezar */
+	while (leer_caracter_timeout(0)>=0)
+		;
+
+	printf("prueba_leer (%d): escribe %d lineas\n", id, LINEAS);
+	llamadas=total=0;
+	for (i=0; i<LINEAS; i++){
+		do {
+			n=leer(buf, TAM_LINEA, LEER_CANONICO);
+			llamadas++;
+			total+=n;
+			buf[n]='\0';
+			fin=(n>0 && buf[n-1]=='\n');
+			if (fin)
+				buf[n-1]='\0';
+			printf("prueba_leer (%d): linea \"%s\"\n", id, buf);
+		} while (n>0 && !fin);
+	}
+	printf("prueba_leer (%d): canonico, %d caracteres en %d llamadas\n",
+		id, total, llamadas);
+
+	printf("prueba_leer (%d): pega o teclea texto en los proximos %d segundos\n",
+		id, ESPERA);
+	dormir(ESPERA);
+	n=leer(buf, TAM_LINEA, LEER_CRUDO);
+	printf("prueba_leer (%d): crudo, %d caracteres en 1 llamada\n", id, n);
+
+	printf("prueba_leer (%d): termina\n", id);
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * usuario/prueba_log.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que lee el registro de la consola del nucleo con
+ * leer_log. Descarta lo anterior, escribe una marca, duerme ESPERA ticks
+ * y despues lee todo lo nuevo y cuenta las lineas, las de interrupcion de
+ * reloj y si esta su propia marca. La espera es corta para que lo escrito
+ * en ella quepa en el registro. Despues repite con el umbral de log en
+ * LOG_INFO, con el que ya no deben aparecer las trazas del reloj.
+ */
+
+#include "servicios.h"
+
+#define ESPERA 20
+#define TAM_LOG 4096
+
+static char log[TAM_LOG];
+
+/* indica si la linea que empieza en lin comienza por pref */
+static int empieza_por(char *lin, char *fin, char *pref){
+	for (; *pref; lin++, pref++)
+		if (lin==fin || *lin!=*pref)
+			return 0;
+	return 1;
+}
+
+/* descarta el registro, escribe la marca, duerme y muestra lo registrado */
+static void medir(char *titulo){
+	int n, total, lineas, reloj, marca;
+	char *lin, *p;
+
+	while (leer_log(log, TAM_LOG)>0)
+		;
+
+	printf("prueba_log: marca\n");
+	dormir_ticks(ESPERA);
+
+	total=lineas=reloj=marca=0;
+	while ((n=leer_log(log, TAM_LOG))>0){
+		total+=n;
+		for (lin=p=log; p<log+n; p++)
+			if (*p=='\n'){
+				lineas++;
+				reloj+=empieza_por(lin, p, "-> TRATANDO INT. DE RELOJ");
+				marca+=empieza_por(lin, p, "prueba_log: marca");
+				lin=p+1;
+			}
+	}
+	printf("prueba_log: %s, %d bytes, %d lineas, %d de reloj, marca %s\n",
+		titulo, total, lineas, reloj, marca ? "encontrada" : "NO ENCONTRADA");
+}
+
+int main(){
+	int anterior;
+
+	printf("prueba_log: comienza\n");
+
+	medir("umbral inicial");
+
+	if ((anterior=fijar_umbral_log(LOG_INFO))<0)
+		printf("prueba_log: error fijando el umbral. NO DEBE APARECER\n");
+	medir("umbral LOG_INFO");
+	fijar_umbral_log(anterior);
+
+	if (fijar_umbral_log(LOG_TRAZA+1)>=0)
+		printf("prueba_log: acepta un umbral no valido. NO DEBE APARECER\n");
+
+	printf("prueba_log: termina\n");
+	return 0;
+}
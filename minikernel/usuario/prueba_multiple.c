@@ -0,0 +1,64 @@
+/*
+ * usuario/prueba_multiple.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba lock_multiple. Crea las cuentas "origen"
+ * y "destino", protegidas cada una por un mutex, y lanza transferidor1 y
+ * transferidor2, que piden los dos mutex en orden contrario. Tomandolos
+ * de uno en uno se interbloquearian; con lock_multiple deben terminar
+ * los dos. A la vez lanza dos cajero, que toman el mutex de "origen" con
+ * lock uno detras de otro, de modo que nunca queda libre: los
+ * transferidores deben conseguirlo en su turno y acabar antes que los
+ * cajeros. Antes comprueba que se rechazan los conjuntos no validos.
+ */
+
+#include "servicios.h"
+
+int main(){
+	unsigned int cuentas[3];
+	int origen, destino;
+
+	printf("prueba_multiple: comienza\n");
+
+	if ((origen=crear_mutex("origen", NO_RECURSIVO))<0 ||
+	    (destino=crear_mutex("destino", NO_RECURSIVO))<0){
+		printf("prueba_multiple: error creando mutex. NO DEBE APARECER\n");
+		return 1;
+	}
+	cuentas[0]=origen;
+	cuentas[1]=destino;
+
+	/* un mutex repetido o un conjunto vacio no son validos */
+	cuentas[2]=cuentas[0];
+	if (lock_multiple(cuentas, 3)==0)
+		printf("prueba_multiple: conjunto repetido aceptado. NO DEBE APARECER\n");
+	if (lock_multiple(cuentas, 0)==0)
+		printf("prueba_multiple: conjunto vacio aceptado. NO DEBE APARECER\n");
+
+	/* tomados juntos, un lock suelto de uno de ellos es un interbloqueo */
+	lock_multiple(cuentas, 2);
+	if (lock(cuentas[1])==0)
+		printf("prueba_multiple: lock propio aceptado. NO DEBE APARECER\n");
+	unlock_multiple(cuentas, 2);
+	if (unlock(cuentas[0])==0)
+		printf("prueba_multiple: unlock tras unlock_multiple aceptado. NO DEBE APARECER\n");
+
+	if (crear_proceso("cajero")<0 || crear_proceso("cajero")<0)
+		printf("Error creando cajero\n");
+	if (crear_proceso("transferidor1")<0)
+		printf("Error creando transferidor1\n");
+	if (crear_proceso("transferidor2")<0)
+		printf("Error creando transferidor2\n");
+
+	/* mantiene los mutex abiertos mientras trabajan */
+	dormir(2);
+
+	printf("prueba_multiple: termina\n");
+	return 0; 
+}
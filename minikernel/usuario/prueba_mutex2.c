@@ -1,9 +1,9 @@
 /*
  * usuario/prueba_mutex.c
  *
- *  Minikernel. Versin 1.0
+ *  Minikernel. Versión 1.0
  *
- *  Fernando Prez Costoya
+ *  Fernando Pérez Costoya
  *
  */
 
@@ -22,7 +22,7 @@ int main(){
 	if ((desc1=crear_mutex("m1", NO_RECURSIVO))<0)
 		printf("error creando m1. NO DEBE APARECER\n");
 
-	/* Probamos a bloquear un mutex usando un descriptor errneo */
+	/* Probamos a bloquear un mutex usando un descriptor erróneo */
 	if (lock(desc1+1)<0)
 		printf("error en lock de mutex. DEBE APARECER\n");
 
@@ -32,14 +32,14 @@ int main(){
 	if (lock(desc1)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
-	/* segundo lock sobre semforo no recursivo -> error */
+	/* segundo lock sobre semáforo no recursivo -> error */
 	if (lock(desc1)<0)
 		printf("segundo lock en mutex no recursivo. DEBE APARECER\n");
 
 	if (lock(desc2)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
-	/* segundo lock sobre semforo recursivo -> correcto */
+	/* segundo lock sobre semáforo recursivo -> correcto */
 	if (lock(desc2)<0)
 		printf("error en lock de mutex. NO DEBE APARECER\n");
 
@@ -49,14 +49,14 @@ int main(){
 	if (crear_proceso("mutex2")<0)
 		printf("Error creando mutex2\n");
 
-	printf("prueba_mutex duerme 1 seg.: ejecutarn los procesos mutex1 y mutex2 que se bloquearn en lock de mutex\n");
+	printf("prueba_mutex duerme 1 seg.: ejecutarán los procesos mutex1 y mutex2 que se bloquearán en lock de mutex\n");
 	dormir(1);
 
 	/* No debe despertar a nadie */
 	if (unlock(desc2)<0)
 		printf("error en unlock de mutex. NO DEBE APARECER\n");
 
-	printf("prueba_mutex duerme 1 seg.: no ejecutar ningn proceso ya que los mutex estn bloqueados\n");
+	printf("prueba_mutex duerme 1 seg.: no ejecutará ningún proceso ya que los mutex están bloqueados\n");
 	dormir(1);
 
 	/* Debe despertar al proceso mutex1 */
@@ -66,8 +66,8 @@ int main(){
 	printf("prueba_mutex duerme 1 seg.: debe ejecutar mutex1 ya que se ha liberado el mutex m2\n");
 	dormir(1);
 
-	printf("prueba_mutex termina: debe ejecutar mutex2 ya que el cierre implcito de m1 debe despertarlo y mutex1 est dormido\n");
+	printf("prueba_mutex termina: debe ejecutar mutex2 ya que el cierre implícito de m1 debe despertarlo y mutex1 está dormido\n");
 
-	/* cierre implcito de semforos: debe despertar a mutex2 */
+	/* cierre implícito de semáforos: debe despertar a mutex2 */
 	return 0;
 }
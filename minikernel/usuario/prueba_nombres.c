@@ -0,0 +1,50 @@
+/*
+ * usuario/prueba_nombres.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba el espacio de nombres del nucleo. Crea,
+ * abre y cierra muchas veces mutex con nombre y muestra las entradas
+ * comparadas de media en cada busqueda, que debe estar cerca de 1 sin
+ * depender del numero de mutex. Tambien comprueba que se rechaza un
+ * nombre demasiado largo.
+ */
+
+#include "servicios.h"
+
+#define RONDAS 200
+
+int main(){
+	struct coste_nombres antes, despues;
+	char nombre[]="nomXY";
+	int i, d1, d2;
+
+	printf("prueba_nombres: comienza\n");
+
+	if (crear_mutex("nombre_demasiado_largo", NO_RECURSIVO)>=0)
+		printf("nombre largo aceptado. NO DEBE APARECER\n");
+
+	coste_nombres(&antes);
+	for (i=0; i<RONDAS; i++){
+		nombre[3]='a'+i%26;
+		nombre[4]='a'+i/26%26;
+		if ((d1=crear_mutex(nombre, NO_RECURSIVO))<0)
+			printf("error creando %s. NO DEBE APARECER\n", nombre);
+		if ((d2=abrir_mutex(nombre))<0)
+			printf("error abriendo %s. NO DEBE APARECER\n", nombre);
+		cerrar_mutex(d2);
+		cerrar_mutex(d1);
+	}
+	coste_nombres(&despues);
+
+	printf("prueba_nombres: %d busquedas, %d comparaciones\n",
+		despues.busquedas-antes.busquedas,
+		despues.comparaciones-antes.comparaciones);
+	printf("prueba_nombres: termina\n");
+	return 0; 
+}
@@ -0,0 +1,57 @@
+/*
+ * usuario/prueba_periodo.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba las llamadas de dormir con resolucion
+ * de tick. Repite NUM_PERIODOS veces un trabajo de TRABAJO ticks con un
+ * periodo de PERIODO ticks, primero durmiendo el periodo con dormir_ticks
+ * y luego hasta el siguiente limite de periodo con dormir_hasta. Con la
+ * primera el trabajo se acumula como deriva; con la segunda no.
+ */
+
+#include "servicios.h"
+
+#define PERIODO 10
+#define TRABAJO 3
+#define NUM_PERIODOS 20
+
+/* Gasta CPU durante ticks ticks de reloj */
+static void trabajar(int ticks){
+	int inicio=obtener_ticks();
+
+	while (obtener_ticks()-inicio < ticks);
+}
+
+int main(){
+	int i, inicio, siguiente, total;
+
+	printf("prueba_periodo: comienza\n");
+
+	inicio=obtener_ticks();
+	for (i=0; i<NUM_PERIODOS; i++){
+		trabajar(TRABAJO);
+		dormir_ticks(PERIODO);
+	}
+	total=obtener_ticks()-inicio;
+	printf("prueba_periodo: dormir_ticks, %d ticks para %d periodos (deriva %d)\n",
+		total, NUM_PERIODOS, total-NUM_PERIODOS*PERIODO);
+
+	inicio=siguiente=obtener_ticks();
+	for (i=0; i<NUM_PERIODOS; i++){
+		trabajar(TRABAJO);
+		siguiente+=PERIODO;
+		dormir_hasta(siguiente);
+	}
+	total=obtener_ticks()-inicio;
+	printf("prueba_periodo: dormir_hasta, %d ticks para %d periodos (deriva %d)\n",
+		total, NUM_PERIODOS, total-NUM_PERIODOS*PERIODO);
+
+	printf("prueba_periodo: termina\n");
+	return 0; 
+}
@@ -0,0 +1,104 @@
+/*
+ * usuario/prueba_plazos.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba las variantes de las llamadas bloqueantes
+ * que no esperan o esperan con plazo. Lanza acaparador, que toma el mutex
+ * "plazo" y lo suelta a los ACAPARA ticks, y comprueba que trylock falla
+ * enseguida, que lock_timeout vence al cumplirse el plazo si es corto y
+ * consigue el mutex si es largo. Luego repite lock_timeout con el plazo corto
+ * mientras acaparador suelta el mutex en el mismo tick en que vence, o en
+ * uno cercano: cada vez o lo consigue o vence, pero nunca vence quedandose
+ * como propietario, y al final el mutex queda libre. Despues comprueba que
+ * leer_caracter_timeout
+ * vence si no se teclea nada mas y que intentar_crear_mutex falla en vez de
+ * esperar cuando ya no quedan mutex libres.
+ */
+
+#include "servicios.h"
+
+#define ACAPARA 50	/* lo mismo que en acaparador */
+#define PLAZO_CORTO 10
+#define PLAZO_LARGO 100
+#define RONDAS 12	/* lo mismo que en acaparador */
+
+int main(){
+	int plazo, listo, hecho, inicio, res, n, conseguidos;
+	char nombre[8];
+
+	printf("prueba_plazos: comienza\n");
+
+	if ((listo=crear_sem("listo", 0))<0 || (hecho=crear_sem("hecho", 0))<0 ||
+	    crear_proceso("acaparador")<0){
+		printf("prueba_plazos: error lanzando acaparador. NO DEBE APARECER\n");
+		return 1;
+	}
+	/* acaparador ya tiene el mutex */
+	esperar_sem(listo);
+	if ((plazo=abrir_mutex("plazo"))<0){
+		printf("prueba_plazos: error abriendo mutex. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	inicio=obtener_ticks();
+	if (trylock(plazo)==0)
+		printf("prueba_plazos: trylock sobre mutex ocupado. NO DEBE APARECER\n");
+	printf("prueba_plazos: trylock falla en %d ticks\n", obtener_ticks()-inicio);
+
+	inicio=obtener_ticks();
+	res=lock_timeout(plazo, PLAZO_CORTO);
+	printf("prueba_plazos: lock_timeout(%d) devuelve %d en %d ticks\n",
+		PLAZO_CORTO, res, obtener_ticks()-inicio);
+
+	inicio=obtener_ticks();
+	res=lock_timeout(plazo, PLAZO_LARGO);
+	printf("prueba_plazos: lock_timeout(%d) devuelve %d en %d ticks\n",
+		PLAZO_LARGO, res, obtener_ticks()-inicio);
+	if (res==0)
+		unlock(plazo);
+
+	/* si vence quedandose como propietario, acaparador no vuelve a
+	   conseguir el mutex y la prueba no acaba */
+	conseguidos=0;
+	for (n=0; n<RONDAS; n++){
+		esperar_sem(listo);
+		if (lock_timeout(plazo, PLAZO_CORTO)==0){
+			conseguidos++;
+			if (unlock(plazo)<0)
+				printf("prueba_plazos: unlock del mutex conseguido falla. NO DEBE APARECER\n");
+		}
+	}
+	esperar_sem(hecho);
+	if (trylock(plazo)<0)
+		printf("prueba_plazos: el mutex no queda libre. NO DEBE APARECER\n");
+	else
+		unlock(plazo);
+	printf("prueba_plazos: %d rondas junto al plazo, %d consiguen el mutex y %d vencen\n",
+		RONDAS, conseguidos, RONDAS-conseguidos);
+
+	/* con plazo 0 solo se recoge lo que ya se haya tecleado */
+	while (leer_caracter_timeout(0)>=0)
+		;
+	inicio=obtener_ticks();
+	res=leer_caracter_timeout(PLAZO_CORTO);
+	printf("prueba_plazos: leer_caracter_timeout(%d) devuelve %d en %d ticks\n",
+		PLAZO_CORTO, res, obtener_ticks()-inicio);
+
+	/* agota los mutex del sistema; el ultimo intento no debe bloquear */
+	nombre[0]='m'; nombre[2]='\0';
+	for (n=0; n<26; n++){
+		nombre[1]='a'+n;
+		if (intentar_crear_mutex(nombre, NO_RECURSIVO)<0)
+			break;
+	}
+	printf("prueba_plazos: intentar_crear_mutex falla tras crear %d\n", n);
+
+	printf("prueba_plazos: termina\n");
+	return 0; 
+}
@@ -0,0 +1,47 @@
+/*
+ * usuario/prueba_prioridad.c
+ *
+ *  Minikernel. Version 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la planificacion por prioridades.
+ * Sube su prioridad, crea dos calculador, que gastan CPU mas tiempo del
+ * que duerme en total, y duerme varias veces hasta un tick dado: cada vez
+ * que despierta debe expulsar al calculador en ejecucion sin esperar a que
+ * termine su rodaja, asi que debe ejecutar en el mismo tick en que
+ * despierta o en el siguiente.
+ */
+
+#include "servicios.h"
+
+#define SUENO 100	/* ticks que duerme cada vez */
+
+int main(){
+	int i, despertar;
+
+	printf("prueba_prioridad: comienza\n");
+
+	if (fijar_prioridad(6)<0)
+		printf("error fijando prioridad. NO DEBE APARECER\n");
+
+	if (fijar_prioridad(100)>=0)
+		printf("prioridad fuera de rango aceptada. NO DEBE APARECER\n");
+
+	for (i=1; i<=2; i++)
+		if (crear_proceso("calculador")<0)
+			printf("Error creando calculador\n");
+
+	for (i=1; i<=3; i++) {
+		despertar=obtener_ticks()+SUENO;
+		dormir_hasta(despertar);
+		printf("prueba_prioridad: despierta %d en el tick %d y ejecuta en el %d\n",
+			i, despertar, obtener_ticks());
+	}
+
+	printf("prueba_prioridad: termina\n");
+	return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * usuario/prueba_prorroga.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que mide el efecto convoy en un mutex muy disputado
+ * y lo que lo reduce la prorroga de rodaja. Lanza NUM_CONVOY procesos
+ * convoy que alternan una seccion critica con el mutex "convoy" y trabajo
+ * fuera de ella; cada uno muestra lo que ha esperado por el mutex. Al final
+ * muestra las prorrogas concedidas. Para comparar se ejecuta con el nucleo
+ * compilado con "make PRORROGA=0" y con, por ejemplo, "make PRORROGA=5".
+ */
+
+#include "servicios.h"
+
+#define NUM_CONVOY 4
+
+int main(){
+	struct prorrogas p;
+	int convoy, hechos, i, inicio;
+
+	printf("prueba_prorroga: comienza\n");
+
+	if ((convoy=crear_mutex("convoy", NO_RECURSIVO))<0 ||
+	    (hechos=crear_sem("hechos", 0))<0){
+		printf("prueba_prorroga: error creando objetos. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	inicio=obtener_ticks();
+	for (i=0; i<NUM_CONVOY; i++)
+		if (crear_proceso("convoy")<0)
+			printf("Error creando convoy\n");
+	for (i=0; i<NUM_CONVOY; i++)
+		esperar_sem(hechos);
+
+	prorrogas(&p);
+	printf("prueba_prorroga: %d ticks en total, %d prorrogas (%d ticks, %d cedidas al soltar)\n",
+		obtener_ticks()-inicio, p.concedidas, p.ticks, p.cedidas);
+
+	/* una seccion critica de usuario tambien puede pedir la prorroga */
+	aplazar_expulsion(1);
+	for (i=0; i<30000000; i++)
+		;
+	aplazar_expulsion(0);
+
+	printf("prueba_prorroga: termina\n");
+	return 0; 
+}
@@ -0,0 +1,67 @@
+/*
+ * usuario/prueba_rwlock.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba los cerrojos de lectores/escritores.
+ * Crea el cerrojo "conf" y lanza NUM_LECTORES lector_rw y NUM_ESCRITORES
+ * escritor_rw que trabajan bajo el. Lo hace dos veces con la misma carga,
+ * con preferencia de lectores y con preferencia de escritores, y muestra
+ * en cada caso las esperas de cada tipo para comparar las dos politicas.
+ */
+
+#include "servicios.h"
+
+#define NUM_LECTORES 4
+#define NUM_ESCRITORES 2
+
+static void probar(char *titulo, int politica, int hechos){
+	struct esperas_rwlock e;
+	int rw, i;
+
+	if ((rw=crear_rwlock("conf", politica))<0){
+		printf("prueba_rwlock: error creando el cerrojo. NO DEBE APARECER\n");
+		return;
+	}
+	if (crear_rwlock("conf", politica)>=0)
+		printf("prueba_rwlock: nombre repetido aceptado. NO DEBE APARECER\n");
+
+	for (i=0; i<NUM_LECTORES; i++)
+		if (crear_proceso("lector_rw")<0)
+			printf("Error creando lector_rw\n");
+	for (i=0; i<NUM_ESCRITORES; i++)
+		if (crear_proceso("escritor_rw")<0)
+			printf("Error creando escritor_rw\n");
+	for (i=0; i<NUM_LECTORES+NUM_ESCRITORES; i++)
+		esperar_sem(hechos);
+
+	esperas_rwlock(rw, &e);
+	printf("prueba_rwlock: %s: lectores %d esperas, %d ticks; escritores %d esperas, %d ticks\n",
+		titulo, e.esperas_lectores, e.ticks_lectores,
+		e.esperas_escritores, e.ticks_escritores);
+
+	/* el cierre libera el nombre para la siguiente prueba */
+	cerrar_rwlock(rw);
+}
+
+int main(){
+	int hechos;
+
+	printf("prueba_rwlock: comienza\n");
+
+	if ((hechos=crear_sem("hechos", 0))<0){
+		printf("prueba_rwlock: error creando semaforo. NO DEBE APARECER\n");
+		return 1;
+	}
+
+	probar("prefiere lectores", PREFIERE_LECTORES, hechos);
+	probar("prefiere escritores", PREFIERE_ESCRITORES, hechos);
+
+	printf("prueba_rwlock: termina\n");
+	return 0; 
+}
@@ -0,0 +1,53 @@
+/*
+ * usuario/prueba_salida.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba la salida con buffer. Escribe LINEAS
+ * lineas en modo linea y otras tantas en modo completo y muestra cuantas
+ * llamadas al sistema ha hecho para cada bloque y en cuantos ticks. Por
+ * ultimo deja una linea a medias en el buffer, que debe aparecer al
+ * terminar el proceso.
+ */
+
+#include "servicios.h"
+
+#define LINEAS 2000
+
+static void bloque(char *titulo){
+	int i, llamadas, inicio;
+
+	llamadas=llamadas_salida();
+	inicio=obtener_ticks();
+	for (i=0; i<LINEAS; i++)
+		printf("prueba_salida: %s, linea %d\n", titulo, i);
+	vaciar_salida();
+	llamadas=llamadas_salida()-llamadas;
+	inicio=obtener_ticks()-inicio;
+	printf("prueba_salida: %s, %d lineas con %d llamadas en %d ticks\n",
+		titulo, LINEAS, llamadas, inicio);
+}
+
+int main(){
+	printf("prueba_salida: comienza\n");
+
+	bloque("modo linea");
+	if (modo_salida(SALIDA_COMPLETA)!=SALIDA_LINEA)
+		printf("prueba_salida: el modo inicial no es SALIDA_LINEA. NO DEBE APARECER\n");
+	bloque("modo completo");
+	modo_salida(SALIDA_LINEA);
+
+	if (modo_salida(SALIDA_COMPLETA+1)>=0)
+		printf("prueba_salida: acepta un modo no valido. NO DEBE APARECER\n");
+
+	printf("prueba_salida: ");
+	printf("termina\n");
+	modo_salida(SALIDA_COMPLETA);
+	printf("prueba_salida: linea a medias sin vaciar al terminar");
+	return 0;
+}
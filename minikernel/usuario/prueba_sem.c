@@ -0,0 +1,35 @@
+/*
+ * usuario/prueba_sem.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que mide el rendimiento de un buffer acotado entre
+ * procesos construido con semaforos contadores. Arranca un productor y
+ * dos consumidores: uno devuelve los huecos de uno en uno (consumidor1)
+ * y otro en lotes (consumidor8), y cada uno muestra los elementos por
+ * tick que ha conseguido.
+ */
+
+#include "servicios.h"
+
+int main(){
+
+	printf("prueba_sem: comienza\n");
+
+	if (crear_proceso("productor")<0)
+		printf("Error creando productor\n");
+
+	if (crear_proceso("consumidor1")<0)
+		printf("Error creando consumidor1\n");
+
+	if (crear_proceso("consumidor8")<0)
+		printf("Error creando consumidor8\n");
+
+	printf("prueba_sem: termina\n");
+	return 0; 
+}
@@ -0,0 +1,31 @@
+/*
+ * usuario/prueba_stride.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba el reparto proporcional por tickets.
+ * Arranca dos procesos que gastan CPU a la vez, uno con 3 tickets y
+ * otro con 1; cada uno muestra la parte de la CPU que ha obtenido, que
+ * con PLANIF_STRIDE debe acercarse al 75% y al 25%.
+ */
+
+#include "servicios.h"
+
+int main(){
+
+	printf("prueba_stride: comienza\n");
+
+	if (crear_proceso("gastador3")<0)
+		printf("Error creando gastador3\n");
+
+	if (crear_proceso("gastador1")<0)
+		printf("Error creando gastador1\n");
+
+	printf("prueba_stride: termina\n");
+	return 0; 
+}
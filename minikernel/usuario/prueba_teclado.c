@@ -0,0 +1,39 @@
+/*
+ * usuario/prueba_teclado.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que prueba el buffer del terminal con una rafaga de
+ * caracteres. Duerme ESPERA segundos sin leer, para que lo que se pegue o
+ * teclee en ese tiempo se acumule en el buffer, y despues lo lee todo sin
+ * esperar y muestra cuantos caracteres ha leido y cuantos se han perdido
+ * por llegar con el buffer lleno.
+ */
+
+#include "servicios.h"
+
+#define ESPERA 3
+
+int main(){
+	int car, leidos=0, perdidos;
+
+	printf("prueba_teclado: comienza\n");
+
+	printf("prueba_teclado: pega o teclea texto en los proximos %d segundos\n",
+		ESPERA);
+	perdidos=caracteres_perdidos();
+	dormir(ESPERA);
+
+	while ((car=leer_caracter_timeout(0))>=0)
+		leidos++;
+	printf("prueba_teclado: %d caracteres leidos, %d perdidos\n",
+		leidos, caracteres_perdidos()-perdidos);
+
+	printf("prueba_teclado: termina\n");
+	return 0;
+}
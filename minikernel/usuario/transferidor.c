@@ -0,0 +1,47 @@
+/*
+ * usuario/transferidor.c
+ *
+ *  Minikernel. Versión 1.0
+ *
+ *  Autores: Zhong Hao Lin Chen, Alvaro Barroso Mato
+ *
+ */
+
+/*
+ * Programa de usuario que hace TRANSFERENCIAS transferencias entre las
+ * cuentas "origen" y "destino" de prueba_multiple, tomando los dos mutex
+ * con lock_multiple. Se compila dos veces: transferidor1 los pide en el
+ * orden origen, destino y transferidor2 (ORDEN_INVERSO) al reves.
+ */
+
+#include "servicios.h"
+
+#define TRANSFERENCIAS 10
+
+int main(){
+	unsigned int cuentas[2];
+	int id, origen, destino, i;
+
+	id=obtener_id_pr();
+	if ((origen=abrir_mutex("origen"))<0 || (destino=abrir_mutex("destino"))<0){
+		printf("transferidor (%d): error abriendo mutex. NO DEBE APARECER\n", id);
+		return 1;
+	}
+#ifdef ORDEN_INVERSO
+	cuentas[0]=destino;
+	cuentas[1]=origen;
+#else
+	cuentas[0]=origen;
+	cuentas[1]=destino;
+#endif
+
+	for (i=0; i<TRANSFERENCIAS; i++){
+		lock_multiple(cuentas, 2);
+		/* la transferencia dura un tick con las dos cuentas tomadas */
+		dormir_ticks(1);
+		unlock_multiple(cuentas, 2);
+	}
+	printf("transferidor (%d): %d transferencias hechas en el tick %d\n", id, TRANSFERENCIAS, obtener_ticks());
+
+	return 0;
+}